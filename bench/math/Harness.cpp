@@ -0,0 +1,109 @@
+#include "Harness.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <numeric>
+
+namespace {
+
+// json string literal of s
+auto quote(const std::string& s) -> std::string {
+  std::string r = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      r += '\\';
+      r += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      r += escaped;
+    } else {
+      r += c;
+    }
+  }
+  return r + "\"";
+}
+
+}  // namespace
+
+auto morpheus::bench::parse_options(int argc, char** argv, Options& options) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (value == nullptr) return false;
+
+    if (std::strcmp(arg, "--repetitions") == 0) {
+      options.repetitions = std::max(1, std::atoi(value));
+    } else if (std::strcmp(arg, "--filter") == 0) {
+      options.filter = value;
+    } else if (std::strcmp(arg, "--json") == 0) {
+      options.json = value;
+    } else if (std::strcmp(arg, "--context") == 0) {
+      const char* separator = std::strchr(value, '=');
+      if (separator == nullptr) return false;
+      options.context.emplace_back(std::string(value, separator), std::string(separator + 1));
+    } else {
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+
+morpheus::bench::Harness::Harness(Options options) : options_(std::move(options)) {}
+
+void morpheus::bench::Harness::add_result(const std::string& name, std::size_t items, std::size_t calls,
+                                          std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+
+  // nearest-rank percentiles
+  auto percentile = [&](double p) {
+    std::size_t rank = static_cast<std::size_t>(p * samples.size() + 0.999999);
+    return samples[std::min(samples.size(), std::max<std::size_t>(rank, 1)) - 1];
+  };
+
+  Result r;
+  r.name = name;
+  r.items = items;
+  r.calls_per_sample = calls;
+  r.median_ns = percentile(0.5);
+  r.p99_ns = percentile(0.99);
+  r.min_ns = samples.front();
+  r.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  results_.push_back(r);
+
+  std::printf("%-40s median %9.3f ns  p99 %9.3f ns  min %9.3f ns\n", name.c_str(), r.median_ns, r.p99_ns, r.min_ns);
+  std::fflush(stdout);
+}
+
+void morpheus::bench::Harness::write_json(std::ostream& out) const {
+  char time[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+  out << "{\n  \"context\": {\n    \"date\": " << quote(time) << ",\n";
+  out << "    \"repetitions\": " << options_.repetitions;
+  for (const auto& entry : options_.context) out << ",\n    " << quote(entry.first) << ": " << quote(entry.second);
+  out << "\n  },\n  \"benchmarks\": [";
+
+  char number[64];
+  auto field = [&](const char* key, double value) {
+    std::snprintf(number, sizeof(number), "%.4f", value);
+    out << ", " << quote(key) << ": " << number;
+  };
+
+  for (std::size_t i = 0; i < results_.size(); ++i) {
+    const Result& r = results_[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << quote(r.name) << ", \"items\": " << r.items
+        << ", \"calls_per_sample\": " << r.calls_per_sample;
+    field("median_ns", r.median_ns);
+    field("p99_ns", r.p99_ns);
+    field("min_ns", r.min_ns);
+    field("mean_ns", r.mean_ns);
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
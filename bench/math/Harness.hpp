@@ -0,0 +1,115 @@
+#ifndef MORPHEUS_BENCH_HARNESS_HPP
+#define MORPHEUS_BENCH_HARNESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+namespace bench {
+
+// keeps value observable, so that the compiler can't drop the work producing it
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// forces the compiler to assume all memory was read and written, so that
+// results stored to arrays are kept and repeated calls can't be collapsed
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+struct Options {
+  int repetitions{101};
+  double warmup_ns{5e6};
+  // calls are batched until a sample takes at least this long, so that the
+  // clock's resolution and overhead don't show in the results
+  double min_sample_ns{2e4};
+  // runs only benchmarks whose name contains filter
+  std::string filter;
+  // file the results are written to as json, none if empty ("-" for stdout)
+  std::string json;
+  // key=value pairs copied to the json context (e.g. commit=...)
+  std::vector<std::pair<std::string, std::string>> context;
+};
+
+// run-math-bench [--repetitions n] [--filter s] [--json file] [--context key=value]...
+// returns false on unknown arguments
+auto parse_options(int argc, char** argv, Options& options) -> bool;
+
+struct Result {
+  std::string name;
+  // elements processed per call, times are per element
+  std::size_t items;
+  std::size_t calls_per_sample;
+  double median_ns;
+  double p99_ns;
+  double min_ns;
+  double mean_ns;
+};
+
+class Harness {
+ private:
+  Options options_;
+  std::vector<Result> results_;
+
+  void add_result(const std::string& name, std::size_t items, std::size_t calls, std::vector<double> samples);
+
+ public:
+  explicit Harness(Options options);
+
+  auto get_options() const -> const Options& { return options_; }
+  auto get_results() const -> const std::vector<Result>& { return results_; }
+
+  // times f, which processes items elements per call. f is warmed up first,
+  // then sampled options.repetitions times
+  template <typename F>
+  void run(const std::string& name, std::size_t items, F f);
+
+  // writes the results and the context given in the options
+  void write_json(std::ostream& out) const;
+};
+
+template <typename F>
+void Harness::run(const std::string& name, std::size_t items, F f) {
+  if (name.find(options_.filter) == std::string::npos) return;
+
+  using clock = std::chrono::steady_clock;
+  auto elapsed_ns = [](clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+  };
+
+  // warmup fills caches and branch predictors, and estimates the cost of a call
+  std::size_t warmup_calls = 0;
+  clock::time_point start = clock::now();
+  double warmup_ns = 0.0;
+  do {
+    f();
+    clobber_memory();
+    ++warmup_calls;
+    warmup_ns = elapsed_ns(start);
+  } while (warmup_ns < options_.warmup_ns);
+
+  double call_ns = warmup_ns / warmup_calls;
+  std::size_t calls = call_ns < options_.min_sample_ns ? static_cast<std::size_t>(options_.min_sample_ns / call_ns) + 1 : 1;
+
+  std::vector<double> samples;
+  samples.reserve(options_.repetitions);
+  for (int rep = 0; rep < options_.repetitions; ++rep) {
+    start = clock::now();
+    for (std::size_t call = 0; call < calls; ++call) {
+      f();
+      clobber_memory();
+    }
+    samples.push_back(elapsed_ns(start) / (calls * items));
+  }
+
+  add_result(name, items, calls, std::move(samples));
+}
+
+}  // namespace bench
+}  // namespace morpheus
+
+#endif  // MORPHEUS_BENCH_HARNESS_HPP
@@ -0,0 +1,580 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <geometry/AABB.hpp>
+#include <geometry/Frustum.hpp>
+#include <geometry/Ray.hpp>
+#include <geometry/Triangle.hpp>
+#include <math/CachedTransform.hpp>
+#include <math/Dispatch.hpp>
+#include <math/Half.hpp>
+#include <math/Matrix3.hpp>
+#include <math/Matrix4.hpp>
+#include <math/Point3.hpp>
+#include <math/Projection.hpp>
+#include <math/Quaternion.hpp>
+#include <math/RigidTransform.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+#include <math/Vector3A.hpp>
+#include <math/Vector4.hpp>
+
+#include "Harness.hpp"
+
+namespace {
+
+using morpheus::bench::Harness;
+using morpheus::bench::do_not_optimize;
+
+// elements per call, small enough for all arrays to stay in l1/l2
+const std::size_t count = 1024;
+
+// element access through a call, as the pre-simd library did
+__attribute__((noinline)) auto element(morpheus::Matrix4& m, int row, int col) -> float& { return m(row, col); }
+__attribute__((noinline)) auto element(morpheus::Vector4& v, int i) -> float& { return v[i]; }
+
+// scalar reference kernels equivalent to the pre-simd implementation
+auto reference_multiply(morpheus::Matrix4 a, morpheus::Matrix4 b) -> morpheus::Matrix4 {
+  morpheus::Matrix4 tmp;
+  for (int col = 0; col < 4; ++col) {
+    for (int k = 0; k < 4; ++k) {
+      for (int row = 0; row < 4; ++row) {
+        element(tmp, row, col) += element(a, row, k) * element(b, k, col);
+      }
+    }
+  }
+  return tmp;
+}
+
+auto reference_multiply(morpheus::Matrix4 m, morpheus::Vector4 v) -> morpheus::Vector4 {
+  morpheus::Vector4 tmp;
+  for (int row = 0; row < 4; ++row) {
+    for (int k = 0; k < 4; ++k) {
+      element(tmp, row) += element(m, row, k) * element(v, k);
+    }
+  }
+  return tmp;
+}
+
+auto reference_inverse(morpheus::Matrix4 m) -> morpheus::Matrix4 {
+  const auto& a = reinterpret_cast<const morpheus::Vector3&>(m[0]);
+  const auto& b = reinterpret_cast<const morpheus::Vector3&>(m[1]);
+  const auto& c = reinterpret_cast<const morpheus::Vector3&>(m[2]);
+  const auto& d = reinterpret_cast<const morpheus::Vector3&>(m[3]);
+
+  float x = m(3, 0);
+  float y = m(3, 1);
+  float z = m(3, 2);
+  float w = m(3, 3);
+
+  morpheus::Vector3 s = cross(a, b);
+  morpheus::Vector3 t = cross(c, d);
+  morpheus::Vector3 u = a * y - b * x;
+  morpheus::Vector3 v = c * w - d * z;
+
+  float inv_det = 1.0F / (dot(s, v) + dot(t, u));
+  s *= inv_det;
+  t *= inv_det;
+  u *= inv_det;
+  v *= inv_det;
+
+  morpheus::Vector3 r0 = cross(b, v) + t * y;
+  morpheus::Vector3 r1 = cross(v, a) - t * x;
+  morpheus::Vector3 r2 = cross(d, u) + s * w;
+  morpheus::Vector3 r3 = cross(u, c) - s * z;
+
+  return {{r0.x(), r0.y(), r0.z(), -dot(b, t)},
+          {r1.x(), r1.y(), r1.z(),  dot(a, t)},
+          {r2.x(), r2.y(), r2.z(), -dot(d, s)},
+          {r3.x(), r3.y(), r3.z(),  dot(c, s)}};
+}
+
+// transform product built through nested initializer lists, as before compose
+auto reference_multiply(const morpheus::Transform4& a, const morpheus::Transform4& b) -> morpheus::Transform4 {
+  return {
+    { a(0, 0) * b(0, 0) + a(0, 1) * b(1, 0) + a(0, 2) * b(2, 0),
+      a(0, 0) * b(0, 1) + a(0, 1) * b(1, 1) + a(0, 2) * b(2, 1),
+      a(0, 0) * b(0, 2) + a(0, 1) * b(1, 2) + a(0, 2) * b(2, 2),
+      a(0, 0) * b(0, 3) + a(0, 1) * b(1, 3) + a(0, 2) * b(2, 3) + a(0, 3) },
+    { a(1, 0) * b(0, 0) + a(1, 1) * b(1, 0) + a(1, 2) * b(2, 0),
+      a(1, 0) * b(0, 1) + a(1, 1) * b(1, 1) + a(1, 2) * b(2, 1),
+      a(1, 0) * b(0, 2) + a(1, 1) * b(1, 2) + a(1, 2) * b(2, 2),
+      a(1, 0) * b(0, 3) + a(1, 1) * b(1, 3) + a(1, 2) * b(2, 3) + a(1, 3) },
+    { a(2, 0) * b(0, 0) + a(2, 1) * b(1, 0) + a(2, 2) * b(2, 0),
+      a(2, 0) * b(0, 1) + a(2, 1) * b(1, 1) + a(2, 2) * b(2, 1),
+      a(2, 0) * b(0, 2) + a(2, 1) * b(1, 2) + a(2, 2) * b(2, 2),
+      a(2, 0) * b(0, 3) + a(2, 1) * b(1, 3) + a(2, 2) * b(2, 3) + a(2, 3) }
+  };
+}
+
+// normal matrix through Matrix3::inverse() and a transpose, as computed per draw
+// before get_normal_matrix
+auto reference_normal_matrix(const morpheus::Transform4& h) -> morpheus::Matrix3 {
+  morpheus::Matrix3 m = {h[0], h[1], h[2]};
+  m.inverse();
+  return {{ m(0, 0), m(1, 0), m(2, 0) },
+          { m(0, 1), m(1, 1), m(2, 1) },
+          { m(0, 2), m(1, 2), m(2, 2) }};
+}
+
+// out-of-line wrappers reproducing the cost of calling into the math library
+// before the vector operators were defined inline
+__attribute__((noinline)) auto call_add(morpheus::Vector3 a, const morpheus::Vector3& b) -> morpheus::Vector3 {
+  return a + b;
+}
+
+__attribute__((noinline)) auto call_scale(morpheus::Vector3 v, float s) -> morpheus::Vector3 {
+  return v * s;
+}
+
+__attribute__((noinline)) auto call_dot(const morpheus::Vector3& a, const morpheus::Vector3& b) -> float {
+  return dot(a, b);
+}
+
+// out[i] = f(i) for every element
+template <typename T, typename F>
+auto each(std::vector<T>& out, F f) {
+  return [&out, f]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] = f(i);
+  };
+}
+
+// sum of f(i) over every element
+template <typename F>
+auto reduce(F f) {
+  return [f]() {
+    float acc = 0.0F;
+    for (std::size_t i = 0; i < count; ++i) acc += f(i);
+    do_not_optimize(acc);
+  };
+}
+
+// operators shared by vector3 and vector4
+template <typename V>
+void run_vector(Harness& harness, const std::string& prefix, const std::vector<V>& a, const std::vector<V>& b) {
+  std::vector<V> out(count);
+  float s = 0.5F;
+
+  harness.run(prefix + "/add", count, each(out, [&](std::size_t i) -> V { return a[i] + b[i]; }));
+  harness.run(prefix + "/subtract", count, each(out, [&](std::size_t i) -> V { return a[i] - b[i]; }));
+  harness.run(prefix + "/negate", count, each(out, [&](std::size_t i) -> V { return -a[i]; }));
+  harness.run(prefix + "/scale", count, each(out, [&](std::size_t i) -> V { return a[i] * s; }));
+  harness.run(prefix + "/divide", count, each(out, [&](std::size_t i) -> V { return a[i] / s; }));
+  harness.run(prefix + "/scale_add", count, each(out, [&](std::size_t i) -> V { return a[i] * s + b[i]; }));
+  harness.run(prefix + "/add_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] += a[i];
+  });
+  harness.run(prefix + "/subtract_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] -= a[i];
+  });
+  harness.run(prefix + "/scale_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] *= s;
+  });
+  harness.run(prefix + "/divide_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] /= s;
+  });
+  harness.run(prefix + "/index", count, reduce([&](std::size_t i) { return a[i][i % V::size]; }));
+  harness.run(prefix + "/dot", count, reduce([&](std::size_t i) { return dot(a[i], b[i]); }));
+  harness.run(prefix + "/magnitude", count, reduce([&](std::size_t i) { return magnitude(a[i]); }));
+  harness.run(prefix + "/normalize", count, each(out, [&](std::size_t i) { return normalize(a[i]); }));
+  harness.run(prefix + "/project", count, each(out, [&](std::size_t i) { return project(a[i], b[i]); }));
+  harness.run(prefix + "/reject", count, each(out, [&](std::size_t i) { return reject(a[i], b[i]); }));
+}
+
+void run_vector3(Harness& harness) {
+  std::vector<morpheus::Vector3> a(count), b(count), out(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    a[i] = morpheus::Vector3(0.1F * i, 0.2F * i, 0.3F * i + 1.0F);
+    b[i] = morpheus::Vector3(1.0F, -0.5F * i, 0.25F * i);
+  }
+
+  run_vector(harness, "vector3", a, b);
+  harness.run("vector3/cross", count, each(out, [&](std::size_t i) { return cross(a[i], b[i]); }));
+  harness.run("vector3/normalize_batch", count, [&]() { morpheus::normalize_batch(a, out); });
+
+  // both precision policies, whichever is the default (see Precision.hpp)
+  harness.run("vector3/normalize/precise", count, each(out, [&](std::size_t i) {
+    return morpheus::normalize<morpheus::precision::precise>(a[i]);
+  }));
+  harness.run("vector3/normalize/fast", count, each(out, [&](std::size_t i) {
+    return morpheus::normalize<morpheus::precision::fast>(a[i]);
+  }));
+
+  // the same expressions through out-of-line calls
+  harness.run("vector3/scale_add/out_of_line", count, each(out, [&](std::size_t i) {
+    return call_add(call_scale(a[i], 0.5F), b[i]);
+  }));
+  harness.run("vector3/dot/out_of_line", count, reduce([&](std::size_t i) { return call_dot(a[i], b[i]); }));
+
+  // padded to aligned 16-byte vectors
+  std::vector<morpheus::Vector3A> pa(a.begin(), a.end()), pb(b.begin(), b.end()), pout(count);
+  harness.run("vector3a/dot", count, reduce([&](std::size_t i) { return dot(pa[i], pb[i]); }));
+  harness.run("vector3a/cross", count, each(pout, [&](std::size_t i) { return cross(pa[i], pb[i]); }));
+}
+
+void run_vector4(Harness& harness) {
+  std::vector<morpheus::Vector4> a(count), b(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    a[i] = morpheus::Vector4(0.1F * i, 0.2F * i, 0.3F * i, 1.0F);
+    b[i] = morpheus::Vector4(1.0F, -0.5F * i, 0.25F * i, 0.5F);
+  }
+
+  run_vector(harness, "vector4", a, b);
+}
+
+void run_point3(Harness& harness) {
+  std::vector<morpheus::Point3> p(count), q(count), points(count);
+  std::vector<morpheus::Vector3> v(count), vectors(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    p[i] = morpheus::Point3(0.1F * i, 0.2F * i, 0.3F * i);
+    q[i] = morpheus::Point3(1.0F, -0.5F * i, 0.25F * i);
+    v[i] = morpheus::Vector3(0.5F, 0.5F * i, -1.0F);
+  }
+
+  harness.run("point3/add_vector", count, each(points, [&](std::size_t i) -> morpheus::Point3 { return p[i] + v[i]; }));
+  harness.run("point3/subtract_vector", count, each(points, [&](std::size_t i) -> morpheus::Point3 {
+    return p[i] - v[i];
+  }));
+  harness.run("point3/subtract_point", count, each(vectors, [&](std::size_t i) -> morpheus::Vector3 {
+    return p[i] - q[i];
+  }));
+}
+
+void run_matrix3(Harness& harness) {
+  std::vector<morpheus::Matrix3> m(count), out(count);
+  std::vector<morpheus::Vector3> v(count), vectors(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    v[i] = normalize(morpheus::Vector3(1.0F, 0.01F * i, 0.5F));
+    m[i] = morpheus::make_rotation_matrix(0.001F * i, v[i]);
+  }
+
+  harness.run("matrix3/multiply", count, each(out, [&](std::size_t i) { return m[i] * m[count - 1 - i]; }));
+  harness.run("matrix3/multiply_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] *= m[i];
+  });
+  harness.run("matrix3/multiply_vector", count, each(vectors, [&](std::size_t i) { return m[i] * v[i]; }));
+  harness.run("matrix3/element", count, reduce([&](std::size_t i) { return m[i](i % 3, (i / 3) % 3); }));
+  harness.run("matrix3/determinant", count, reduce([&](std::size_t i) { return determinant(m[i]); }));
+  harness.run("matrix3/inverse", count, each(out, [&](std::size_t i) { return inverse(m[i]); }));
+  harness.run("matrix3/make_rotation_matrix", count, each(out, [&](std::size_t i) {
+    return morpheus::make_rotation_matrix(0.001F * i, v[i]);
+  }));
+  harness.run("matrix3/make_rotation_matrix/precise", count, each(out, [&](std::size_t i) {
+    return morpheus::make_rotation_matrix<morpheus::precision::precise>(0.001F * i, v[i]);
+  }));
+  harness.run("matrix3/make_rotation_matrix/fast", count, each(out, [&](std::size_t i) {
+    return morpheus::make_rotation_matrix<morpheus::precision::fast>(0.001F * i, v[i]);
+  }));
+  harness.run("matrix3/make_rotation_matrix_x/precise", count, each(out, [&](std::size_t i) {
+    return morpheus::make_rotation_matrix_x<morpheus::precision::precise>(0.01F * i);
+  }));
+  harness.run("matrix3/make_rotation_matrix_x/fast", count, each(out, [&](std::size_t i) {
+    return morpheus::make_rotation_matrix_x<morpheus::precision::fast>(0.01F * i);
+  }));
+}
+
+void run_matrix4(Harness& harness) {
+  std::vector<morpheus::Matrix4> m(count), out(count);
+  std::vector<morpheus::Vector4> v(count), vectors(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    for (int row = 0; row < 4; ++row) {
+      for (int col = 0; col < 4; ++col) m[i](row, col) = 0.001F * ((i + row * 4 + col) % 17) + (row == col ? 1.0F : 0.0F);
+      v[i][row] = 0.01F * ((i + row) % 13);
+    }
+  }
+
+  harness.run("matrix4/multiply", count, each(out, [&](std::size_t i) { return m[i] * m[count - 1 - i]; }));
+  harness.run("matrix4/multiply/reference", count, each(out, [&](std::size_t i) {
+    return reference_multiply(m[i], m[count - 1 - i]);
+  }));
+  harness.run("matrix4/multiply_assign", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) out[i] *= m[i];
+  });
+  harness.run("matrix4/multiply_vector", count, each(vectors, [&](std::size_t i) { return m[i] * v[i]; }));
+  harness.run("matrix4/multiply_vector/reference", count, each(vectors, [&](std::size_t i) {
+    return reference_multiply(m[i], v[i]);
+  }));
+  harness.run("matrix4/element", count, reduce([&](std::size_t i) { return m[i](i % 4, (i / 4) % 4); }));
+  harness.run("matrix4/determinant", count, reduce([&](std::size_t i) { return determinant(m[i]); }));
+  harness.run("matrix4/inverse", count, each(out, [&](std::size_t i) { return inverse(m[i]); }));
+  harness.run("matrix4/inverse/reference", count, each(out, [&](std::size_t i) { return reference_inverse(m[i]); }));
+  harness.run("matrix4/inverse_batch", count, [&]() { morpheus::inverse_batch(m, out); });
+}
+
+void run_projection(Harness& harness) {
+  std::vector<morpheus::Point3> points(count);
+  std::vector<morpheus::Vector4> v(count), clip(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    points[i] = morpheus::Point3(0.1F * i, -0.2F * i, -1.0F - 0.3F * i);
+    v[i] = morpheus::Vector4(points[i].x(), points[i].y(), points[i].z(), 1.0F);
+  }
+
+  morpheus::PerspectiveProjection perspective = morpheus::make_perspective(1.2F, 1.5F, 0.5F, 100.0F);
+  morpheus::Matrix4 matrix = perspective.get_matrix();
+  morpheus::OrthographicProjection orthographic = morpheus::make_orthographic(-2.0F, 6.0F, -1.0F, 3.0F, 1.0F, 11.0F);
+
+  harness.run("projection/perspective/multiply_vector", count, each(clip, [&](std::size_t i) { return perspective * v[i]; }));
+  harness.run("projection/perspective/multiply_vector/matrix4", count, each(clip, [&](std::size_t i) {
+    return matrix * v[i];
+  }));
+  harness.run("projection/perspective/multiply_point", count, each(clip, [&](std::size_t i) {
+    return perspective * points[i];
+  }));
+  harness.run("projection/orthographic/multiply_point", count, each(clip, [&](std::size_t i) {
+    return orthographic * points[i];
+  }));
+}
+
+void run_transform4(Harness& harness) {
+  std::vector<morpheus::Transform4> h(count), out(count);
+  std::vector<morpheus::Point3> points(count), transformed_points(count);
+  std::vector<morpheus::Vector3> vectors(count), transformed_vectors(count);
+  std::vector<float> x(count), y(count), z(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, 0.01F * i, 0.5F));
+    morpheus::Matrix3 r = morpheus::make_rotation_matrix(0.001F * i, axis);
+    h[i] = morpheus::Transform4(r[0], r[1], r[2], morpheus::Point3(0.1F * i, 1.0F, -2.0F));
+    points[i] = morpheus::Point3(0.1F * i, 0.2F * i, 0.3F * i);
+    vectors[i] = morpheus::Vector3(-1.0F * i, 0.5F * i, 3.0F);
+    x[i] = points[i].x();
+    y[i] = points[i].y();
+    z[i] = points[i].z();
+  }
+
+  harness.run("transform4/multiply", count, each(out, [&](std::size_t i) { return h[i] * h[count - 1 - i]; }));
+  harness.run("transform4/multiply/reference", count, each(out, [&](std::size_t i) {
+    return reference_multiply(h[i], h[count - 1 - i]);
+  }));
+  harness.run("transform4/compose", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) morpheus::compose(h[i], h[count - 1 - i], out[i]);
+  });
+  harness.run("transform4/compose_batch", count, [&]() { morpheus::compose_batch(h, h, out); });
+  harness.run("transform4/multiply_vector", count, each(transformed_vectors, [&](std::size_t i) {
+    return h[i] * vectors[i];
+  }));
+  harness.run("transform4/multiply_point", count, each(transformed_points, [&](std::size_t i) {
+    return h[i] * points[i];
+  }));
+  harness.run("transform4/inverse", count, each(out, [&](std::size_t i) { return inverse(h[i]); }));
+  std::vector<morpheus::Matrix3> normals(count);
+  std::vector<morpheus::CachedTransform> cached(h.begin(), h.end());
+  harness.run("transform4/normal_matrix/reference", count, each(normals, [&](std::size_t i) {
+    return reference_normal_matrix(h[i]);
+  }));
+  harness.run("transform4/normal_matrix", count, each(normals, [&](std::size_t i) { return get_normal_matrix(h[i]); }));
+  harness.run("transform4/normal_matrix/cached", count, each(normals, [&](std::size_t i) {
+    return cached[i].get_normal_matrix();
+  }));
+  harness.run("transform4/get_normal_matrices", count, [&]() { morpheus::get_normal_matrices(h, normals); });
+  harness.run("transform4/translation", count, reduce([&](std::size_t i) { return h[i].get_translation().x(); }));
+
+  // one transform applied to many elements
+  const morpheus::Transform4& t = h[count / 2];
+  harness.run("transform4/transform_points", count, [&]() {
+    morpheus::transform_points(t, points, transformed_points);
+  });
+  harness.run("transform4/transform_vectors", count, [&]() {
+    morpheus::transform_vectors(t, vectors, transformed_vectors);
+  });
+  std::vector<morpheus::Vector3A> padded(points.begin(), points.end()), transformed_padded(count);
+  harness.run("transform4/transform_points_padded", count, [&]() {
+    morpheus::transform_points(t, padded, transformed_padded);
+  });
+  harness.run("transform4/transform_points_soa", count, [&]() {
+    morpheus::Stream3<float> stream = { x, y, z };
+    morpheus::transform_points(t, morpheus::Stream3<const float>{ x, y, z }, stream);
+  });
+}
+
+// same transforms as run_transform4, so that rigid_transform/inverse compares
+// against transform4/inverse
+void run_rigid_transform(Harness& harness) {
+  std::vector<morpheus::RigidTransform> h(count), out(count);
+  std::vector<morpheus::Point3> points(count), transformed_points(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, 0.01F * i, 0.5F));
+    h[i] = morpheus::RigidTransform(morpheus::make_rotation_matrix(0.001F * i, axis),
+                                    morpheus::Point3(0.1F * i, 1.0F, -2.0F));
+    points[i] = morpheus::Point3(0.1F * i, 0.2F * i, 0.3F * i);
+  }
+
+  harness.run("rigid_transform/inverse", count, each(out, [&](std::size_t i) { return inverse(h[i]); }));
+  harness.run("rigid_transform/multiply", count, each(out, [&](std::size_t i) { return h[i] * h[count - 1 - i]; }));
+  harness.run("rigid_transform/multiply_point", count, each(transformed_points, [&](std::size_t i) {
+    return h[i] * points[i];
+  }));
+}
+
+void run_quaternion(Harness& harness) {
+  std::vector<morpheus::Quaternion> q(count), out(count);
+  std::vector<morpheus::Vector3> v(count), vectors(count);
+  std::vector<morpheus::Matrix3> matrices(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    v[i] = normalize(morpheus::Vector3(1.0F, 0.01F * i, 0.5F));
+    q[i] = morpheus::make_rotation_quaternion(0.001F * i, v[i]);
+  }
+
+  harness.run("quaternion/multiply", count, each(out, [&](std::size_t i) { return q[i] * q[count - 1 - i]; }));
+  harness.run("quaternion/rotate", count, each(vectors, [&](std::size_t i) { return rotate(q[i], v[i]); }));
+  harness.run("quaternion/nlerp", count, each(out, [&](std::size_t i) { return nlerp(q[i], q[count - 1 - i], 0.3F); }));
+  harness.run("quaternion/slerp", count, each(out, [&](std::size_t i) { return slerp(q[i], q[count - 1 - i], 0.3F); }));
+  harness.run("quaternion/get_rotation_matrix", count, each(matrices, [&](std::size_t i) {
+    return q[i].get_rotation_matrix();
+  }));
+  harness.run("quaternion/get_rotation_matrices", count, [&]() { morpheus::get_rotation_matrices(q, matrices); });
+}
+
+// batch kernels of every level the cpu supports (see Dispatch.hpp)
+void run_batch_levels(Harness& harness) {
+  std::vector<morpheus::Matrix4> matrices(count), inverses(count);
+  std::vector<morpheus::Point3> points(count), transformed(count);
+  std::vector<morpheus::Vector3> vectors(count), normalized(count);
+  std::vector<morpheus::Quaternion> quaternions(count);
+  std::vector<morpheus::Matrix3> rotations(count);
+  std::vector<morpheus::Transform4> transforms(count), composed(count);
+  std::vector<morpheus::Vector3h> packed(count);
+  std::vector<morpheus::Vector3A> padded(count), transformed_padded(count);
+  std::vector<morpheus::AABB> boxes(count);
+  bool visible[count];
+  std::vector<morpheus::Triangle> triangles(count);
+  std::vector<float> angles(count), sines(count), cosines(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    transforms[i] = morpheus::Transform4(morpheus::Vector3(1.0F, 0.001F * i, 0.0F), morpheus::Vector3(0.0F, 1.0F, 0.5F),
+                                         morpheus::Vector3(0.0F, 0.0F, 2.0F), morpheus::Point3(0.1F * i, 1.0F, -2.0F));
+    for (int k = 0; k < 4; ++k) matrices[i](k, k) = 1.0F + 0.001F * i;
+    matrices[i](0, 3) = 0.5F;
+    points[i] = morpheus::Point3(0.1F * i, 0.2F * i, 0.3F * i);
+    padded[i] = points[i];
+    vectors[i] = morpheus::Vector3(1.0F, 0.01F * i, 0.5F);
+    quaternions[i] = morpheus::make_rotation_quaternion(0.001F * i, normalize(vectors[i]));
+    angles[i] = 0.01F * i - 5.0F;
+    // about half of the boxes are visible
+    morpheus::Point3 c(0.05F * i - 25.0F, 0.01F * i, -0.1F * i);
+    boxes[i] = morpheus::AABB(c - morpheus::Vector3(1.0F, 1.0F, 1.0F), c + morpheus::Vector3(1.0F, 2.0F, 1.0F));
+    // a 32x32 grid of small triangles in front of the rays below
+    float x = 0.1F * (i % 32);
+    float y = 0.1F * (i / 32);
+    triangles[i] = morpheus::Triangle(morpheus::Point3(x, y, -1.0F), morpheus::Point3(x + 0.09F, y, -1.0F),
+                                      morpheus::Point3(x, y + 0.09F, -1.01F));
+  }
+  morpheus::TriangleStreams triangle_streams(triangles);
+  std::vector<morpheus::Ray> rays;
+  for (int i = 0; i < 64; ++i) {
+    morpheus::Vector3 d(0.02F * (i % 8) - 0.08F, 0.02F * (i / 8) - 0.08F, -1.0F);
+    rays.emplace_back(morpheus::Point3(1.6F, 1.6F, 1.0F), d);
+  }
+  std::vector<morpheus::RayHit> hits(rays.size());
+  morpheus::Transform4 h = {
+    { 0.0F, -1.0F, 0.0F, 1.0F },
+    { 1.0F,  0.0F, 0.0F, 2.0F },
+    { 0.0F,  0.0F, 2.0F, 3.0F }
+  };
+  morpheus::Frustum frustum = morpheus::make_frustum(morpheus::make_perspective(1.0F, 1.5F, 0.5F, 100.0F).get_matrix());
+
+  // per-call paths the batched rotations replace, with axes normalized in place
+  std::vector<morpheus::Vector3> axes(count);
+  morpheus::normalize_batch(vectors, axes);
+  harness.run("batch/make_rotation_matrix/reference", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) rotations[i] = morpheus::make_rotation_matrix(angles[i], axes[i]);
+    morpheus::bench::clobber_memory();
+  });
+  harness.run("batch/make_rotation_matrix/reference_fast", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) {
+      rotations[i] = morpheus::make_rotation_matrix<morpheus::precision::fast>(angles[i], axes[i]);
+    }
+    morpheus::bench::clobber_memory();
+  });
+  harness.run("batch/intersect_triangles/reference", count, [&]() {
+    float t = 100.0F;
+    float u;
+    float v;
+    for (std::size_t i = 0; i < count; ++i) intersect(rays[0], triangles[i], t, t, u, v);
+    morpheus::bench::do_not_optimize(t);
+  });
+  harness.run("batch/intersects/reference", count, [&]() {
+    for (std::size_t i = 0; i < count; ++i) visible[i] = intersects(frustum, boxes[i]);
+    morpheus::bench::clobber_memory();
+  });
+
+  morpheus::SimdLevel active = morpheus::get_simd_level();
+  for (int l = 0; l <= static_cast<int>(morpheus::get_supported_simd_level()); ++l) {
+    std::string level = morpheus::to_string(morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l)));
+    harness.run("batch/transform_points/" + level, count, [&]() { morpheus::transform_points(h, points, transformed); });
+    harness.run("batch/transform_points_padded/" + level, count, [&]() {
+      morpheus::transform_points(h, padded, transformed_padded);
+    });
+    harness.run("batch/compose_batch/" + level, count, [&]() {
+      morpheus::compose_batch(transforms, transforms, composed);
+    });
+    harness.run("batch/inverse_batch/" + level, count, [&]() { morpheus::inverse_batch(matrices, inverses); });
+    harness.run("batch/normalize_batch/" + level, count, [&]() { morpheus::normalize_batch(vectors, normalized); });
+    harness.run("batch/get_rotation_matrices/" + level, count, [&]() {
+      morpheus::get_rotation_matrices(quaternions, rotations);
+    });
+    harness.run("batch/sincos_batch/" + level, count, [&]() { morpheus::sincos_batch(angles, sines, cosines); });
+    harness.run("batch/make_rotation_matrices/" + level, count, [&]() {
+      morpheus::make_rotation_matrices(angles, axes, rotations);
+    });
+    harness.run("batch/get_normal_matrices/" + level, count, [&]() {
+      morpheus::get_normal_matrices(transforms, rotations);
+    });
+    harness.run("batch/intersects_batch/" + level, count, [&]() {
+      morpheus::bench::do_not_optimize(morpheus::intersects_batch(frustum, boxes, visible));
+    });
+    harness.run("batch/intersect_triangles/" + level, count, [&]() {
+      intersect(rays[0], triangle_streams, 100.0F, hits[0]);
+      morpheus::bench::clobber_memory();
+    });
+    harness.run("batch/intersect_rays/" + level, count * rays.size(), [&]() {
+      morpheus::bench::do_not_optimize(intersect(rays, triangle_streams, 100.0F, hits));
+    });
+    harness.run("batch/to_half/" + level, count, [&]() { morpheus::to_half(vectors, packed); });
+    harness.run("batch/to_float/" + level, count, [&]() { morpheus::to_float(packed, normalized); });
+  }
+  morpheus::set_simd_level(active);
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  morpheus::bench::Options options;
+  if (!morpheus::bench::parse_options(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--repetitions n] [--filter s] [--json file] [--context key=value]...\n", argv[0]);
+    return 1;
+  }
+  options.context.emplace_back("simd_level", morpheus::to_string(morpheus::get_simd_level()));
+  options.context.emplace_back("compiler", __VERSION__);
+#if defined(MORPHEUS_BUILD_TYPE)
+  options.context.emplace_back("build_type", MORPHEUS_BUILD_TYPE);
+#endif
+
+  std::printf("simd level %s (supported %s)\n", morpheus::to_string(morpheus::get_simd_level()),
+              morpheus::to_string(morpheus::get_supported_simd_level()));
+
+  Harness harness(options);
+  run_vector3(harness);
+  run_vector4(harness);
+  run_point3(harness);
+  run_matrix3(harness);
+  run_matrix4(harness);
+  run_projection(harness);
+  run_transform4(harness);
+  run_rigid_transform(harness);
+  run_quaternion(harness);
+  run_batch_levels(harness);
+
+  if (options.json == "-") {
+    harness.write_json(std::cout);
+  } else if (!options.json.empty()) {
+    std::ofstream out(options.json);
+    harness.write_json(out);
+    if (!out) {
+      std::fprintf(stderr, "can't write %s\n", options.json.c_str());
+      return 1;
+    }
+  }
+  return 0;
+}
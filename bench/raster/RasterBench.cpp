@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <math/Dispatch.hpp>
+#include <math/Point3.hpp>
+#include <math/Projection.hpp>
+#include <math/Vector4.hpp>
+#include <math/VectorFixed.hpp>
+#include <raster/Framebuffer.hpp>
+#include <raster/Rasterizer.hpp>
+#include <raster/TiledRasterizer.hpp>
+
+#include "Harness.hpp"
+
+namespace {
+
+using morpheus::bench::Harness;
+
+const int width = 640;
+const int height = 480;
+
+// count triangles of about size pixels on a side, at random positions and depths in
+// front of the camera, as clip-space positions
+auto make_triangles(std::size_t count, float size, std::vector<morpheus::Vector4>& clip,
+                    std::vector<std::uint32_t>& colors) {
+  morpheus::PerspectiveProjection p = morpheus::make_perspective(1.0F, float(width) / height, 0.5F, 100.0F);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+  std::uniform_real_distribution<float> depth(2.0F, 20.0F);
+
+  clip.clear();
+  colors.clear();
+  for (std::size_t i = 0; i < count; ++i) {
+    float z = depth(rng);
+    // half the view height at depth z is about 0.55 z for a fovy of 1
+    float x = 0.7F * z * unit(rng);
+    float y = 0.5F * z * unit(rng);
+    float s = 1.1F * z * size / height;
+    clip.push_back(p * morpheus::Point3(x, y, -z));
+    clip.push_back(p * morpheus::Point3(x + s * unit(rng), y + s, -z));
+    clip.push_back(p * morpheus::Point3(x + s, y + s * unit(rng), -z));
+    colors.push_back(static_cast<std::uint32_t>(rng()));
+  }
+}
+
+// triangles per call, times are per triangle. the target is cleared by every call,
+// raster/clear gives the cost of that alone
+void run_draw_triangles(Harness& harness) {
+  morpheus::Framebuffer target(width, height);
+  harness.run("raster/clear", 1, [&]() {
+    target.clear(0);
+    morpheus::bench::clobber_memory();
+  });
+
+  struct Case {
+    const char* name;
+    std::size_t count;
+    float size;
+  };
+  const Case cases[] = {{"small", 16384, 4.0F}, {"medium", 4096, 16.0F}, {"large", 256, 64.0F}};
+
+  morpheus::SimdLevel active = morpheus::get_simd_level();
+  for (const Case& c : cases) {
+    std::vector<morpheus::Vector4> clip;
+    std::vector<std::uint32_t> colors;
+    make_triangles(c.count, c.size, clip, colors);
+
+    // setup only, no pixels
+    std::vector<morpheus::TriangleSetup> setups(c.count);
+    std::size_t n = 0;
+    harness.run(std::string("raster/setup_triangle/") + c.name, c.count, [&]() {
+      n = 0;
+      for (std::size_t i = 0; i < c.count; ++i) {
+        morpheus::Vector3fx v[3];
+        if (to_window(clip[3 * i], width, height, v[0]) && to_window(clip[3 * i + 1], width, height, v[1]) &&
+            to_window(clip[3 * i + 2], width, height, v[2]) &&
+            setup_triangle(v[0], v[1], v[2], colors[i], width, height, setups[n])) {
+          ++n;
+        }
+      }
+      morpheus::bench::clobber_memory();
+    });
+
+    for (int l = 0; l <= static_cast<int>(morpheus::get_supported_simd_level()); ++l) {
+      std::string level = morpheus::to_string(morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l)));
+      harness.run(std::string("raster/draw_triangles/") + c.name + "/" + level, c.count, [&]() {
+        target.clear(0);
+        morpheus::bench::do_not_optimize(draw_triangles(clip, colors, target));
+      });
+    }
+  }
+  morpheus::set_simd_level(active);
+}
+
+// triangles of about size units on a side scattered through a box around the
+// camera, so that some are behind it or cross the near plane and many are outside
+// the view or cross its sides
+auto make_scene(std::size_t count, float size, std::vector<morpheus::Vector4>& clip,
+                std::vector<std::uint32_t>& colors) {
+  morpheus::PerspectiveProjection p = morpheus::make_perspective(1.0F, float(width) / height, 0.5F, 100.0F);
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+  std::uniform_real_distribution<float> depth(-2.0F, 40.0F);
+
+  clip.clear();
+  colors.clear();
+  for (std::size_t i = 0; i < count; ++i) {
+    float z = depth(rng);
+    float x = 20.0F * unit(rng);
+    float y = 5.0F * unit(rng);
+    clip.push_back(p * morpheus::Point3(x, y, -z));
+    clip.push_back(p * morpheus::Point3(x + size * unit(rng), y + size, -z + size * unit(rng)));
+    clip.push_back(p * morpheus::Point3(x + size, y + size * unit(rng), -z + size * unit(rng)));
+    colors.push_back(static_cast<std::uint32_t>(rng()));
+  }
+}
+
+// guard-band clipping on scenes around the camera, per triangle. prints where the
+// triangles went, the share that went straight to setup is the one that avoided
+// the clipper
+void run_clip(Harness& harness) {
+  morpheus::Framebuffer target(width, height);
+
+  struct Case {
+    const char* name;
+    std::size_t count;
+    float size;
+  };
+  const Case cases[] = {{"small", 4096, 0.5F}, {"medium", 4096, 2.0F}, {"large", 1024, 8.0F}};
+
+  for (const Case& c : cases) {
+    std::string name = std::string("raster/clip/") + c.name;
+    if (name.find(harness.get_options().filter) == std::string::npos) continue;
+
+    std::vector<morpheus::Vector4> clip;
+    std::vector<std::uint32_t> colors;
+    make_scene(c.count, c.size, clip, colors);
+
+    morpheus::ClipStats stats;
+    target.clear(0);
+    std::size_t drawn = draw_triangles(clip, colors, target, &stats);
+    double total = static_cast<double>(stats.triangles);
+    std::size_t visible = stats.triangles - stats.culled;
+    std::printf("clip %s: %zu triangles, %.1f%% culled, %.1f%% clipped, %.1f%% avoid the clipper (%.1f%% of the "
+                "ones not culled), %zu setups\n",
+                c.name, stats.triangles, 100.0 * stats.culled / total, 100.0 * stats.clipped / total,
+                100.0 * (stats.triangles - stats.clipped) / total,
+                100.0 * (visible - stats.clipped) / static_cast<double>(visible), drawn);
+
+    harness.run(name, c.count, [&]() {
+      target.clear(0);
+      morpheus::bench::do_not_optimize(draw_triangles(clip, colors, target));
+    });
+  }
+}
+
+// sort-middle on 1 to n threads, n the hardware threads, for a few tile sizes, at
+// the active simd level. compare with raster/draw_triangles for the cost of binning.
+// prints the speedup of each thread count over 1 thread
+void run_tiled(Harness& harness) {
+  morpheus::Framebuffer target(width, height);
+  std::vector<int> thread_counts;
+  int hardware_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  for (int n = 1; n < hardware_threads; n *= 2) thread_counts.push_back(n);
+  thread_counts.push_back(hardware_threads);
+  std::printf("tiled: %d hardware threads\n", hardware_threads);
+
+  struct Case {
+    const char* name;
+    std::size_t count;
+    float size;
+  };
+  const Case cases[] = {{"small", 16384, 4.0F}, {"medium", 4096, 16.0F}};
+  const int tile_sizes[] = {32, 64, 128};
+
+  for (const Case& c : cases) {
+    std::vector<morpheus::Vector4> clip;
+    std::vector<std::uint32_t> colors;
+    make_triangles(c.count, c.size, clip, colors);
+    for (int tile_size : tile_sizes) {
+      std::string scaling;
+      double one_thread_ns = 0.0;
+      for (int threads : thread_counts) {
+        morpheus::TiledRasterizer tiled(tile_size, threads);
+        std::string name = std::string("raster/tiled/") + c.name + "/" + std::to_string(tile_size) + "/" +
+                           std::to_string(threads);
+        std::size_t results = harness.get_results().size();
+        harness.run(name, c.count, [&]() {
+          target.clear(0);
+          morpheus::bench::do_not_optimize(tiled.draw_triangles(clip, colors, target));
+        });
+        if (harness.get_results().size() == results) continue;
+
+        double ns = harness.get_results().back().median_ns;
+        if (threads == 1) one_thread_ns = ns;
+        char speedup[32];
+        std::snprintf(speedup, sizeof(speedup), " %d: %.2fx", threads, one_thread_ns / ns);
+        if (one_thread_ns > 0.0) scaling += speedup;
+      }
+      if (!scaling.empty()) std::printf("tiled %s/%d speedup over 1 thread,%s\n", c.name, tile_size, scaling.c_str());
+    }
+  }
+}
+
+// large triangles on a target small enough to stay in the caches, so that the
+// kernels rather than memory bandwidth set the pace: two triangles covering the
+// target (times per pixel) and random triangles spanning most of it (per triangle),
+// without setup
+void run_fill(Harness& harness) {
+  const int size = 256;
+  morpheus::Framebuffer target(size, size);
+  morpheus::Vector3fx v[4] = {
+    {morpheus::Subpixel(0), morpheus::Subpixel(0), morpheus::Subpixel(0)},
+    {morpheus::Subpixel(size), morpheus::Subpixel(0), morpheus::Subpixel(0)},
+    {morpheus::Subpixel(size), morpheus::Subpixel(size), morpheus::Subpixel(0)},
+    {morpheus::Subpixel(0), morpheus::Subpixel(size), morpheus::Subpixel(0)},
+  };
+  morpheus::TriangleSetup quad[2];
+  setup_triangle(v[0], v[1], v[2], 1, size, size, quad[0]);
+  setup_triangle(v[0], v[2], v[3], 2, size, size, quad[1]);
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> position(-0.25F * size, 1.25F * size);
+  std::vector<morpheus::TriangleSetup> large;
+  while (large.size() < 64) {
+    morpheus::TriangleSetup t;
+    morpheus::Vector3fx w[3];
+    for (morpheus::Vector3fx& p : w) p = {morpheus::Subpixel(position(rng)), morpheus::Subpixel(position(rng)),
+                                          morpheus::Subpixel(0)};
+    if (setup_triangle(w[0], w[1], w[2], 3, size, size, t)) large.push_back(t);
+  }
+
+  morpheus::SimdLevel active = morpheus::get_simd_level();
+  for (int l = 0; l <= static_cast<int>(morpheus::get_supported_simd_level()); ++l) {
+    std::string level = morpheus::to_string(morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l)));
+    // the depth test passes every time
+    harness.run("raster/fill/" + level, std::size_t(size) * size, [&]() {
+      target.clear(0);
+      rasterize(quad, target);
+    });
+    harness.run("raster/rasterize/large/" + level, large.size(), [&]() {
+      target.clear(0);
+      rasterize(large, target);
+    });
+  }
+  morpheus::set_simd_level(active);
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  morpheus::bench::Options options;
+  if (!morpheus::bench::parse_options(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--repetitions n] [--filter s] [--json file] [--context key=value]...\n", argv[0]);
+    return 1;
+  }
+  options.context.emplace_back("simd_level", morpheus::to_string(morpheus::get_simd_level()));
+  options.context.emplace_back("compiler", __VERSION__);
+#if defined(MORPHEUS_BUILD_TYPE)
+  options.context.emplace_back("build_type", MORPHEUS_BUILD_TYPE);
+#endif
+
+  std::printf("simd level %s (supported %s)\n", morpheus::to_string(morpheus::get_simd_level()),
+              morpheus::to_string(morpheus::get_supported_simd_level()));
+
+  Harness harness(options);
+  run_draw_triangles(harness);
+  run_tiled(harness);
+  run_clip(harness);
+  run_fill(harness);
+
+  if (options.json == "-") {
+    harness.write_json(std::cout);
+  } else if (!options.json.empty()) {
+    std::ofstream out(options.json);
+    harness.write_json(out);
+    if (!out) {
+      std::fprintf(stderr, "can't write %s\n", options.json.c_str());
+      return 1;
+    }
+  }
+  return 0;
+}
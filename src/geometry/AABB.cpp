@@ -0,0 +1,44 @@
+#include "AABB.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+auto morpheus::merge(const AABB& a, const AABB& b) -> AABB {
+  const Point3& a0 = a.get_min();
+  const Point3& a1 = a.get_max();
+  const Point3& b0 = b.get_min();
+  const Point3& b1 = b.get_max();
+  return {{std::min(a0.x(), b0.x()), std::min(a0.y(), b0.y()), std::min(a0.z(), b0.z())},
+          {std::max(a1.x(), b1.x()), std::max(a1.y(), b1.y()), std::max(a1.z(), b1.z())}};
+}
+
+auto morpheus::make_aabb(span<const Point3> points) -> AABB {
+  assert(!points.empty());
+
+  Point3 lo = points[0];
+  Point3 hi = points[0];
+  for (const Point3& p : points) {
+    for (unsigned int i = 0; i < 3; ++i) {
+      lo[i] = std::min(lo[i], p[i]);
+      hi[i] = std::max(hi[i], p[i]);
+    }
+  }
+  return {lo, hi};
+}
+
+auto morpheus::operator*(const Transform4& h, const AABB& b) -> AABB {
+  Point3 c = h * b.get_center();
+  Vector3 e = b.get_extent();
+
+  Vector3 r;
+  for (int row = 0; row < 3; ++row) {
+    r[row] = std::abs(h(row, 0)) * e.x() + std::abs(h(row, 1)) * e.y() + std::abs(h(row, 2)) * e.z();
+  }
+  return {c - r, c + r};
+}
@@ -0,0 +1,63 @@
+#ifndef MORPHEUS_AABB_HPP
+#define MORPHEUS_AABB_HPP
+
+#include <cassert>
+
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+namespace morpheus {
+
+// axis-aligned bounding box, empty boxes are not representable. 24 bytes, min
+// and max in order
+class AABB {
+ private:
+  Point3 min_;
+  Point3 max_;
+
+ public:
+  AABB() = default;
+  constexpr AABB(const Point3& min, const Point3& max) : min_(min), max_(max) {
+    assert(min.x() <= max.x() && min.y() <= max.y() && min.z() <= max.z());
+  }
+
+  constexpr auto get_min() const -> const Point3& { return min_; }
+  constexpr auto get_max() const -> const Point3& { return max_; }
+
+  constexpr auto get_center() const -> Point3 {
+    return {(min_.x() + max_.x()) * 0.5F, (min_.y() + max_.y()) * 0.5F, (min_.z() + max_.z()) * 0.5F};
+  }
+
+  // half the size along each axis
+  constexpr auto get_extent() const -> Vector3 { return (max_ - min_) * 0.5F; }
+};
+
+constexpr auto contains(const AABB& b, const Point3& p) -> bool {
+  return    b.get_min().x() <= p.x() && p.x() <= b.get_max().x()
+         && b.get_min().y() <= p.y() && p.y() <= b.get_max().y()
+         && b.get_min().z() <= p.z() && p.z() <= b.get_max().z();
+}
+
+constexpr auto intersects(const AABB& a, const AABB& b) -> bool {
+  return    a.get_min().x() <= b.get_max().x() && b.get_min().x() <= a.get_max().x()
+         && a.get_min().y() <= b.get_max().y() && b.get_min().y() <= a.get_max().y()
+         && a.get_min().z() <= b.get_max().z() && b.get_min().z() <= a.get_max().z();
+}
+
+// smallest box containing both
+auto merge(const AABB& a, const AABB& b) -> AABB;
+
+// smallest box containing the points, which must not be empty
+auto make_aabb(span<const Point3> points) -> AABB;
+
+// box around the transformed box (Arvo, Graphics Gems 1990) in its center and
+// extent form: the center is transformed as a point and every new half size is
+// the sum of the old ones weighted by the absolute values of a row, instead of
+// transforming all eight corners
+auto operator*(const Transform4& h, const AABB& b) -> AABB;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_AABB_HPP
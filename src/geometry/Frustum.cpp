@@ -0,0 +1,48 @@
+#include "Frustum.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include <math/Dispatch.hpp>
+#include <math/Matrix4.hpp>
+#include <math/Span.hpp>
+#include <math/Vector3.hpp>
+
+namespace {
+
+static_assert(sizeof(morpheus::Plane) == 4 * sizeof(float), "batched kernels expect packed planes");
+static_assert(sizeof(morpheus::AABB) == 6 * sizeof(float), "batched kernels expect packed boxes");
+
+auto make_plane(const morpheus::Matrix4& m, int row, float sign) -> morpheus::Plane {
+  morpheus::Vector3 n(m(3, 0) + sign * m(row, 0), m(3, 1) + sign * m(row, 1), m(3, 2) + sign * m(row, 2));
+  return normalize(morpheus::Plane(n, m(3, 3) + sign * m(row, 3)));
+}
+
+}  // namespace
+
+auto morpheus::make_frustum(const Matrix4& m) -> Frustum {
+  // -w <= x, x <= w, -w <= y, y <= w, 0 <= z and z <= w, with x, y, z, w the
+  // dot products of the rows of m with a point
+  Plane near_plane = normalize(Plane(Vector3(m(2, 0), m(2, 1), m(2, 2)), m(2, 3)));
+  return {make_plane(m, 0, 1.0F), make_plane(m, 0, -1.0F), make_plane(m, 1, 1.0F), make_plane(m, 1, -1.0F),
+          near_plane, make_plane(m, 2, -1.0F)};
+}
+
+auto morpheus::intersects(const Frustum& f, const AABB& b) -> bool {
+  Point3 c = b.get_center();
+  Vector3 e = b.get_extent();
+  for (int i = 0; i < Frustum::plane_count; ++i) {
+    const Vector3& n = f.get_plane(i).get_normal();
+    float r = std::abs(n.x()) * e.x() + std::abs(n.y()) * e.y() + std::abs(n.z()) * e.z();
+    if (distance(f.get_plane(i), c) + r < 0.0F) return false;
+  }
+  return true;
+}
+
+auto morpheus::intersects_batch(const Frustum& f, span<const AABB> boxes, span<bool> visible) -> std::size_t {
+  assert(visible.size() >= boxes.size());
+  return get_batch_kernels().intersect_boxes(reinterpret_cast<const float*>(f.get_planes()),
+                                             reinterpret_cast<const float*>(boxes.data()), visible.data(),
+                                             boxes.size());
+}
@@ -0,0 +1,68 @@
+#ifndef MORPHEUS_FRUSTUM_HPP
+#define MORPHEUS_FRUSTUM_HPP
+
+#include <cstddef>
+
+#include <math/Matrix4.hpp>
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+
+#include "AABB.hpp"
+#include "Plane.hpp"
+#include "Sphere.hpp"
+
+namespace morpheus {
+
+// convex volume bounded by six planes with unit normals pointing inwards, in the
+// order left, right, bottom, top, near, far
+class Frustum {
+ private:
+  Plane planes_[6];
+
+ public:
+  static const int plane_count = 6;
+
+  Frustum() = default;
+  constexpr Frustum(const Plane& left, const Plane& right, const Plane& bottom, const Plane& top,
+                    const Plane& near_plane, const Plane& far_plane)
+      : planes_{left, right, bottom, top, near_plane, far_plane} {}
+
+  constexpr auto get_plane(int i) const -> const Plane& { return planes_[i]; }
+  constexpr auto get_planes() const -> const Plane* { return planes_; }
+};
+
+// planes of the clip volume of m, which maps to clip space with x and y in
+// [-w, w] and depth in [0, w] (see Projection.hpp), in the space m maps from:
+// a projection gives a view space frustum, projection * view a world space one
+// (Gribb and Hartmann, 2001)
+auto make_frustum(const Matrix4& m) -> Frustum;
+
+constexpr auto contains(const Frustum& f, const Point3& p) -> bool {
+  for (int i = 0; i < Frustum::plane_count; ++i) {
+    if (distance(f.get_plane(i), p) < 0.0F) return false;
+  }
+  return true;
+}
+
+// the tests below are conservative: false means the shape is outside, true that it
+// is inside or intersects, or is close to a corner of the frustum while outside
+
+constexpr auto intersects(const Frustum& f, const Sphere& s) -> bool {
+  for (int i = 0; i < Frustum::plane_count; ++i) {
+    if (distance(f.get_plane(i), s.get_center()) < -s.get_radius()) return false;
+  }
+  return true;
+}
+
+// a box is outside a plane if its center is farther behind it than the projection
+// of its extent onto the normal
+auto intersects(const Frustum& f, const AABB& b) -> bool;
+
+// visible[i] = intersects(f, boxes[i]) with the kernels of the current simd level,
+// 8 boxes per iteration with avx2 and 16 with avx-512 (see Dispatch.hpp). returns
+// the number of visible boxes. visible must hold at least as many elements as boxes
+auto intersects_batch(const Frustum& f, span<const AABB> boxes, span<bool> visible) -> std::size_t;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_FRUSTUM_HPP
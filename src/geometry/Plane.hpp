@@ -0,0 +1,40 @@
+#ifndef MORPHEUS_PLANE_HPP
+#define MORPHEUS_PLANE_HPP
+
+#include <cmath>
+
+#include <math/Point3.hpp>
+#include <math/Vector3.hpp>
+
+namespace morpheus {
+
+// points p with dot(n, p) + d = 0. the normal points into the positive half-space,
+// which is the inside for the planes of a Frustum. 16 bytes, n and d in order
+class Plane {
+ private:
+  Vector3 normal_;
+  float offset_{0.0F};
+
+ public:
+  Plane() = default;
+  constexpr Plane(const Vector3& normal, float offset) : normal_(normal), offset_(offset) {}
+  constexpr Plane(const Vector3& normal, const Point3& p) : normal_(normal), offset_(-dot(normal, p)) {}
+
+  constexpr auto get_normal() const -> const Vector3& { return normal_; }
+  constexpr auto get_offset() const -> float { return offset_; }
+};
+
+// signed distance in units of the normal's length, positive on the side it points to
+constexpr auto distance(const Plane& f, const Point3& p) -> float {
+  return dot(f.get_normal(), p) + f.get_offset();
+}
+
+// scales the plane to a unit normal, so that distance is euclidean
+inline auto normalize(const Plane& f) -> Plane {
+  float inv_length = 1.0F / std::sqrt(dot(f.get_normal(), f.get_normal()));
+  return {f.get_normal() * inv_length, f.get_offset() * inv_length};
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_PLANE_HPP
@@ -0,0 +1,116 @@
+#include "Ray.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include <math/Dispatch.hpp>
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+#include <math/Vector3.hpp>
+
+namespace {
+
+static_assert(sizeof(morpheus::Ray) == 6 * sizeof(float), "batched kernels expect packed rays");
+static_assert(sizeof(morpheus::RayHit) == 4 * sizeof(float), "batched kernels expect packed hits");
+
+// the nine streams of the triangles, as the batch kernels take them
+struct Streams {
+  const float* p[9];
+
+  explicit Streams(const morpheus::TriangleStreams& triangles) {
+    for (int k = 0; k < 9; ++k) p[k] = triangles.get_stream(k);
+  }
+};
+
+}  // namespace
+
+auto morpheus::intersect(const Ray& r, const AABB& b, float t_max, float& t) -> bool {
+  float t0 = 0.0F;
+  float t1 = t_max;
+  for (unsigned int i = 0; i < 3; ++i) {
+    float inv_d = 1.0F / r.get_direction()[i];
+    float t_near = (b.get_min()[i] - r.get_origin()[i]) * inv_d;
+    float t_far = (b.get_max()[i] - r.get_origin()[i]) * inv_d;
+    if (t_near > t_far) std::swap(t_near, t_far);
+
+    // written so that a nan (0 * inf, an origin on the slab of a parallel ray)
+    // keeps the previous bound
+    t0 = t_near > t0 ? t_near : t0;
+    t1 = t_far < t1 ? t_far : t1;
+    if (t0 > t1) return false;
+  }
+  t = t0;
+  return true;
+}
+
+auto morpheus::intersect(const Ray& r, const Plane& f, float t_max, float& t) -> bool {
+  float d = dot(f.get_normal(), r.get_direction());
+  if (d == 0.0F) return false;
+
+  float s = -distance(f, r.get_origin()) / d;
+  if (s < 0.0F || s > t_max) return false;
+  t = s;
+  return true;
+}
+
+auto morpheus::intersect(const Ray& r, const Sphere& s, float t_max, float& t) -> bool {
+  // roots of |o + d t - c|^2 = radius^2
+  Vector3 m = r.get_origin() - s.get_center();
+  float a = dot(r.get_direction(), r.get_direction());
+  float b = dot(m, r.get_direction());
+  float c = dot(m, m) - s.get_radius() * s.get_radius();
+
+  // origin outside and pointing away
+  if (c > 0.0F && b > 0.0F) return false;
+
+  float discriminant = b * b - a * c;
+  if (discriminant < 0.0F) return false;
+
+  float u = (-b - std::sqrt(discriminant)) / a;
+  if (u < 0.0F) u = 0.0F;
+  if (u > t_max) return false;
+  t = u;
+  return true;
+}
+
+auto morpheus::intersect(const Ray& r, const Triangle& tri, float t_max, float& t, float& u, float& v) -> bool {
+  Vector3 e1 = tri.get_b() - tri.get_a();
+  Vector3 e2 = tri.get_c() - tri.get_a();
+
+  // solves o + d t = a + e1 u + e2 v with cramer's rule, the determinant is
+  // dot(e1, cross(d, e2)). parallel rays get an infinite inverse and fail the
+  // tests below with infinities or nans
+  Vector3 p = cross(r.get_direction(), e2);
+  float inv_det = 1.0F / dot(e1, p);
+
+  Vector3 s = r.get_origin() - tri.get_a();
+  float hit_u = dot(s, p) * inv_det;
+  Vector3 q = cross(s, e1);
+  float hit_v = dot(r.get_direction(), q) * inv_det;
+  float hit_t = dot(e2, q) * inv_det;
+
+  if (!(0.0F <= hit_u && 0.0F <= hit_v && hit_u + hit_v <= 1.0F && 0.0F <= hit_t && hit_t < t_max)) return false;
+  t = hit_t;
+  u = hit_u;
+  v = hit_v;
+  return true;
+}
+
+auto morpheus::intersect(const Ray& r, const TriangleStreams& triangles, float t_max, RayHit& hit) -> bool {
+  get_batch_kernels().intersect_triangles(reinterpret_cast<const float*>(&r), Streams(triangles).p,
+                                          triangles.size(), t_max, reinterpret_cast<float*>(&hit));
+  return hit.index != RayHit::none;
+}
+
+auto morpheus::intersect(span<const Ray> rays, const TriangleStreams& triangles, float t_max, span<RayHit> hits)
+    -> std::size_t {
+  assert(hits.size() >= rays.size());
+  get_batch_kernels().intersect_rays(reinterpret_cast<const float*>(rays.data()), rays.size(), Streams(triangles).p,
+                                     triangles.size(), t_max, reinterpret_cast<float*>(hits.data()));
+
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < rays.size(); ++i) n += hits[i].index != RayHit::none ? 1 : 0;
+  return n;
+}
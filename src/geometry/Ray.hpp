@@ -0,0 +1,68 @@
+#ifndef MORPHEUS_RAY_HPP
+#define MORPHEUS_RAY_HPP
+
+#include <cstddef>
+
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+#include "AABB.hpp"
+#include "Plane.hpp"
+#include "Sphere.hpp"
+#include "Triangle.hpp"
+
+namespace morpheus {
+
+// points origin + direction * t for t >= 0. the direction needn't be normalized,
+// t is measured in multiples of it
+class Ray {
+ private:
+  Point3 origin_;
+  Vector3 direction_;
+
+ public:
+  Ray() = default;
+  constexpr Ray(const Point3& origin, const Vector3& direction) : origin_(origin), direction_(direction) {}
+
+  constexpr auto get_origin() const -> const Point3& { return origin_; }
+  constexpr auto get_direction() const -> const Vector3& { return direction_; }
+
+  constexpr auto at(float t) const -> Point3 { return origin_ + direction_ * t; }
+};
+
+inline auto operator*(const Transform4& h, const Ray& r) -> Ray {
+  return {h * r.get_origin(), h * r.get_direction()};
+}
+
+// the intersection functions return false if the ray misses, otherwise t is the
+// smallest parameter in [0, t_max] where the ray enters the shape (0 if it starts
+// inside it)
+
+// slab test, rays parallel to a slab rely on the infinities of ieee division
+auto intersect(const Ray& r, const AABB& b, float t_max, float& t) -> bool;
+auto intersect(const Ray& r, const Plane& f, float t_max, float& t) -> bool;
+auto intersect(const Ray& r, const Sphere& s, float t_max, float& t) -> bool;
+
+// moller and trumbore (1997), both sides of the triangle, u and v are the
+// barycentric coordinates of b and c at the hit. rays parallel to the plane of
+// the triangle and degenerate triangles miss
+auto intersect(const Ray& r, const Triangle& tri, float t_max, float& t, float& u, float& v) -> bool;
+
+// nearest of the triangles the ray hits in [0, t_max), with the kernels of the
+// current simd level (see Dispatch.hpp): 8 triangles per iteration with avx2 and
+// 16 with avx-512. without a hit, hit.index is RayHit::none and hit.t is t_max
+auto intersect(const Ray& r, const TriangleStreams& triangles, float t_max, RayHit& hit) -> bool;
+
+// the same for packets of rays against one triangle at a time, 4 rays with sse,
+// 8 with avx2 and 16 with avx-512, which suits coherent rays (e.g. the shadow
+// rays of neighbouring pixels) better. rays that don't fill a packet are
+// tested like a single ray. returns the number of rays that hit a triangle.
+// hits must hold at least as many elements as rays
+auto intersect(span<const Ray> rays, const TriangleStreams& triangles, float t_max, span<RayHit> hits)
+    -> std::size_t;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_RAY_HPP
@@ -0,0 +1,20 @@
+#include "Sphere.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+auto morpheus::operator*(const Transform4& h, const Sphere& s) -> Sphere {
+  // the largest scale is the largest singular value of the 3x3 block, the square
+  // root of the largest eigenvalue of the gram matrix of its columns. that is at
+  // most the largest absolute row sum of the gram matrix (gershgorin), exact for
+  // orthogonal columns (rotation and scale) and a safe bound under shear
+  float g01 = std::abs(dot(h[0], h[1]));
+  float g02 = std::abs(dot(h[0], h[2]));
+  float g12 = std::abs(dot(h[1], h[2]));
+  float scale = std::max(std::max(dot(h[0], h[0]) + g01 + g02, dot(h[1], h[1]) + g01 + g12),
+                         dot(h[2], h[2]) + g02 + g12);
+  return {h * s.get_center(), s.get_radius() * std::sqrt(scale)};
+}
@@ -0,0 +1,42 @@
+#ifndef MORPHEUS_SPHERE_HPP
+#define MORPHEUS_SPHERE_HPP
+
+#include <cassert>
+
+#include <math/Point3.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+namespace morpheus {
+
+class Sphere {
+ private:
+  Point3 center_;
+  float radius_{0.0F};
+
+ public:
+  Sphere() = default;
+  constexpr Sphere(const Point3& center, float radius) : center_(center), radius_(radius) { assert(radius >= 0.0F); }
+
+  constexpr auto get_center() const -> const Point3& { return center_; }
+  constexpr auto get_radius() const -> float { return radius_; }
+};
+
+constexpr auto contains(const Sphere& s, const Point3& p) -> bool {
+  Vector3 d = p - s.get_center();
+  return dot(d, d) <= s.get_radius() * s.get_radius();
+}
+
+constexpr auto intersects(const Sphere& a, const Sphere& b) -> bool {
+  Vector3 d = b.get_center() - a.get_center();
+  float r = a.get_radius() + b.get_radius();
+  return dot(d, d) <= r * r;
+}
+
+// sphere around the transformed sphere, the radius grows by the largest scale of
+// the 3x3 block (or a little more under shear, never less)
+auto operator*(const Transform4& h, const Sphere& s) -> Sphere;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_SPHERE_HPP
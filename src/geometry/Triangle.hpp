@@ -0,0 +1,71 @@
+#ifndef MORPHEUS_TRIANGLE_HPP
+#define MORPHEUS_TRIANGLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <math/Point3.hpp>
+#include <math/Span.hpp>
+#include <math/Vector3.hpp>
+
+namespace morpheus {
+
+class Triangle {
+ private:
+  Point3 a_;
+  Point3 b_;
+  Point3 c_;
+
+ public:
+  Triangle() = default;
+  constexpr Triangle(const Point3& a, const Point3& b, const Point3& c) : a_(a), b_(b), c_(c) {}
+
+  constexpr auto get_a() const -> const Point3& { return a_; }
+  constexpr auto get_b() const -> const Point3& { return b_; }
+  constexpr auto get_c() const -> const Point3& { return c_; }
+};
+
+// triangles in structure-of-arrays layout for the batched ray tests in Ray.hpp:
+// vertex a and the edges b - a and c - a, one stream per coordinate, so that a
+// simd register loads the same coordinate of consecutive triangles
+class TriangleStreams {
+ private:
+  // a.x, a.y, a.z, (b - a).x, ..., (c - a).z
+  std::vector<float> streams_[9];
+
+ public:
+  TriangleStreams() = default;
+  explicit TriangleStreams(span<const Triangle> triangles) {
+    for (const Triangle& t : triangles) push_back(t);
+  }
+
+  void push_back(const Triangle& t) {
+    Vector3 e1 = t.get_b() - t.get_a();
+    Vector3 e2 = t.get_c() - t.get_a();
+    for (unsigned int k = 0; k < 3; ++k) {
+      streams_[k].push_back(t.get_a()[k]);
+      streams_[3 + k].push_back(e1[k]);
+      streams_[6 + k].push_back(e2[k]);
+    }
+  }
+
+  auto size() const -> std::size_t { return streams_[0].size(); }
+  auto get_stream(int k) const -> const float* { return streams_[k].data(); }
+};
+
+// nearest hit of a ray: the parameter t along the ray, the barycentric
+// coordinates u and v of vertices b and c (a has 1 - u - v) and the index of the
+// triangle. 16 bytes, as the batch kernels write it
+struct RayHit {
+  static constexpr std::uint32_t none = 0xffffffff;
+
+  float t;
+  float u;
+  float v;
+  std::uint32_t index;
+};
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_TRIANGLE_HPP
@@ -0,0 +1,1202 @@
+#include "BatchKernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Simd.hpp"
+
+// compiled once per instruction set level with -march set accordingly (see
+// CMakeLists.txt), MORPHEUS_KERNEL_LEVEL names the namespace of the table.
+// this file must not call inline functions of the library headers: every copy
+// would be compiled for a different instruction set and the linker keeps one of
+// them, which could then run on a cpu that doesn't support it. everything below
+// has internal linkage and only depends on the intrinsics headers
+
+#if !defined(MORPHEUS_KERNEL_LEVEL)
+#define MORPHEUS_KERNEL_LEVEL scalar
+#endif
+
+namespace {
+
+// packs of lanes with the operations the kernels need beyond the arithmetic
+// operators, which gcc and clang provide for the simd types. simd packs are made
+// of 128-bit lanes of 4 floats, broadcast4 repeats 4 floats in every lane,
+// gather4/scatter4 move lane j from/to p + j * stride and transpose4 transposes
+// 4x4 blocks within each 128-bit lane. load_strided loads element j from
+// p + j * stride. comparisons give a mask, with select picking a where it is set
+// and b elsewhere and bits turning it into an int with bit j for lane j.
+// as_uint/as_float reinterpret the floats as unsigned ints and back, for bit
+// manipulations with the operators of the vector types
+struct Lanes1 {
+  using type = float;
+  using mask = bool;
+  using uint_type = std::uint32_t;
+  static const int width = 1;
+
+  static auto load(const float* p) -> type { return *p; }
+  static void store(float* p, type v) { *p = v; }
+  static auto set1(float f) -> type { return f; }
+  static auto sqrt(type v) -> type { return __builtin_sqrtf(v); }
+  static auto load_strided(const float* p, std::size_t) -> type { return *p; }
+  static auto lt(type a, type b) -> mask { return a < b; }
+  static auto le(type a, type b) -> mask { return a <= b; }
+  static auto both(mask a, mask b) -> mask { return a && b; }
+  static auto select(mask m, type a, type b) -> type { return m ? a : b; }
+  static auto bits(mask m) -> int { return m ? 1 : 0; }
+
+  static auto as_uint(type v) -> uint_type {
+    uint_type u;
+    std::memcpy(&u, &v, sizeof(u));
+    return u;
+  }
+
+  static auto as_float(uint_type u) -> type {
+    type v;
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+  }
+
+  static void load3(const float* p, type& x, type& y, type& z) {
+    x = p[0];
+    y = p[1];
+    z = p[2];
+  }
+
+  static void store3(float* p, type x, type y, type z) {
+    p[0] = x;
+    p[1] = y;
+    p[2] = z;
+  }
+};
+
+#if defined(MORPHEUS_SSE)
+typedef std::uint32_t uint32x4 __attribute__((vector_size(16)));
+
+struct Lanes4 {
+  using type = __m128;
+  using mask = __m128;
+  using uint_type = uint32x4;
+  static const int width = 4;
+
+  static auto load(const float* p) -> type { return _mm_loadu_ps(p); }
+  static void store(float* p, type v) { _mm_storeu_ps(p, v); }
+  static auto set1(float f) -> type { return _mm_set1_ps(f); }
+  static auto sqrt(type v) -> type { return _mm_sqrt_ps(v); }
+  static auto load_strided(const float* p, std::size_t stride) -> type {
+    return _mm_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride]);
+  }
+  static auto lt(type a, type b) -> mask { return _mm_cmplt_ps(a, b); }
+  static auto le(type a, type b) -> mask { return _mm_cmple_ps(a, b); }
+  static auto both(mask a, mask b) -> mask { return _mm_and_ps(a, b); }
+#if defined(MORPHEUS_SSE4_1)
+  static auto select(mask m, type a, type b) -> type { return _mm_blendv_ps(b, a, m); }
+#else
+  static auto select(mask m, type a, type b) -> type { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#endif
+  static auto bits(mask m) -> int { return _mm_movemask_ps(m); }
+  static auto as_uint(type v) -> uint_type { return reinterpret_cast<uint_type>(v); }
+  static auto as_float(uint_type u) -> type { return reinterpret_cast<type>(u); }
+
+  // x0y0z0x1 y1z1x2y2 z2x3y3z3 <-> x, y, z
+  static void load3(const float* p, type& x, type& y, type& z) {
+    __m128 p0 = _mm_loadu_ps(p);
+    __m128 p1 = _mm_loadu_ps(p + 4);
+    __m128 p2 = _mm_loadu_ps(p + 8);
+
+    __m128 xy23 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 1, 3, 2));
+    __m128 xy01 = _mm_shuffle_ps(p0, _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 1, 0));
+    x = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)),
+                       _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+  }
+
+  static void store3(float* p, type x, type y, type z) {
+    __m128 xy_lo = _mm_unpacklo_ps(x, y);
+    __m128 xy_hi = _mm_unpackhi_ps(x, y);
+    _mm_storeu_ps(p, _mm_shuffle_ps(xy_lo, _mm_shuffle_ps(z, xy_lo, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(xy_lo, z, _MM_SHUFFLE(1, 1, 3, 3)), xy_hi,
+                                        _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, xy_hi, _MM_SHUFFLE(2, 2, 2, 2)),
+                                        _mm_shuffle_ps(xy_hi, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+  }
+
+  static auto broadcast4(const float* p) -> type { return _mm_loadu_ps(p); }
+
+  // element K of every 128-bit lane
+  template <int K>
+  static auto splat(type v) -> type { return _mm_shuffle_ps(v, v, K * 0x55); }
+
+  static auto gather4(const float* p, std::size_t) -> type { return _mm_loadu_ps(p); }
+  static void scatter4(float* p, std::size_t, type v) { _mm_storeu_ps(p, v); }
+
+  static void transpose4(type& r0, type& r1, type& r2, type& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+  // bit mask of the lanes with a determinant at most bound (see singular_bound),
+  // inv_det is zero in those lanes
+  static auto singular(type det, type bound, type& inv_det) -> int {
+    __m128 abs_det = _mm_andnot_ps(_mm_set1_ps(-0.0F), det);
+    __m128 mask = _mm_cmple_ps(abs_det, bound);
+    inv_det = _mm_andnot_ps(mask, _mm_div_ps(_mm_set1_ps(1.0F), det));
+    return _mm_movemask_ps(mask);
+  }
+};
+#endif
+
+#if defined(MORPHEUS_AVX2)
+typedef std::uint32_t uint32x8 __attribute__((vector_size(32)));
+
+struct Lanes8 {
+  using type = __m256;
+  using mask = __m256;
+  using uint_type = uint32x8;
+  static const int width = 8;
+
+  static auto load(const float* p) -> type { return _mm256_loadu_ps(p); }
+  static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+  static auto set1(float f) -> type { return _mm256_set1_ps(f); }
+  static auto sqrt(type v) -> type { return _mm256_sqrt_ps(v); }
+  static auto load_strided(const float* p, std::size_t stride) -> type {
+    __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                       _mm256_set1_epi32(static_cast<int>(stride)));
+    return _mm256_i32gather_ps(p, index, 4);
+  }
+  static auto lt(type a, type b) -> mask { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static auto le(type a, type b) -> mask { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static auto both(mask a, mask b) -> mask { return _mm256_and_ps(a, b); }
+  static auto select(mask m, type a, type b) -> type { return _mm256_blendv_ps(b, a, m); }
+  static auto bits(mask m) -> int { return _mm256_movemask_ps(m); }
+  static auto as_uint(type v) -> uint_type { return reinterpret_cast<uint_type>(v); }
+  static auto as_float(uint_type u) -> type { return reinterpret_cast<type>(u); }
+
+  // x0y0z0x1 y1z1x2y2 z2x3y3z3 | x4y4z4x5 y5z5x6y6 z6x7y7z7 <-> x, y, z
+  static void load3(const float* p, type& x, type& y, type& z) {
+    __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 0)), _mm_loadu_ps(p + 12), 1);
+    __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+    __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+    __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+    __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+  }
+
+  static void store3(float* p, type x, type y, type z) {
+    __m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm256_storeu_ps(p + 0, _mm256_permute2f128_ps(r03, r14, 0x20));
+    _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(r25, r03, 0x30));
+    _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(r14, r25, 0x31));
+  }
+
+  static auto broadcast4(const float* p) -> type { return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p)); }
+
+  template <int K>
+  static auto splat(type v) -> type { return _mm256_permute_ps(v, K * 0x55); }
+
+  static auto gather4(const float* p, std::size_t stride) -> type {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + stride), 1);
+  }
+
+  static void scatter4(float* p, std::size_t stride, type v) {
+    _mm_storeu_ps(p, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(p + stride, _mm256_extractf128_ps(v, 1));
+  }
+
+  static void transpose4(type& r0, type& r1, type& r2, type& r3) {
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+
+  static auto singular(type det, type bound, type& inv_det) -> int {
+    __m256 abs_det = _mm256_andnot_ps(_mm256_set1_ps(-0.0F), det);
+    __m256 mask = _mm256_cmp_ps(abs_det, bound, _CMP_LE_OQ);
+    inv_det = _mm256_andnot_ps(mask, _mm256_div_ps(_mm256_set1_ps(1.0F), det));
+    return _mm256_movemask_ps(mask);
+  }
+};
+#endif
+
+#if defined(MORPHEUS_AVX512)
+// indices of the two-source permutes between 16 x, y, z triples and x, y, z registers
+struct Permutes16 {
+  alignas(64) int deinterleave[3][2][16]{};
+  alignas(64) int interleave[3][2][16]{};
+
+  constexpr Permutes16() {
+    // element k of component c is float 3k + c, which is in the first two
+    // registers for 3k + c < 32 and in the third one otherwise
+    for (int c = 0; c < 3; ++c) {
+      for (int k = 0; k < 16; ++k) {
+        int s = 3 * k + c;
+        deinterleave[c][0][k] = s < 32 ? s : 0;
+        deinterleave[c][1][k] = s < 32 ? k : 16 + s - 32;
+      }
+    }
+    // float i of output register r is component (16r + i) % 3 of point (16r + i) / 3,
+    // x and y are picked first and z second
+    for (int r = 0; r < 3; ++r) {
+      for (int i = 0; i < 16; ++i) {
+        int p = (16 * r + i) / 3;
+        int c = (16 * r + i) % 3;
+        interleave[r][0][i] = c == 0 ? p : (c == 1 ? 16 + p : 0);
+        interleave[r][1][i] = c == 2 ? 16 + p : i;
+      }
+    }
+  }
+};
+
+constexpr Permutes16 permutes;
+
+typedef std::uint32_t uint32x16 __attribute__((vector_size(64)));
+
+struct Lanes16 {
+  using type = __m512;
+  using mask = __mmask16;
+  using uint_type = uint32x16;
+  static const int width = 16;
+
+  static auto load(const float* p) -> type { return _mm512_loadu_ps(p); }
+  static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+  static auto set1(float f) -> type { return _mm512_set1_ps(f); }
+  static auto sqrt(type v) -> type { return _mm512_sqrt_ps(v); }
+  static auto load_strided(const float* p, std::size_t stride) -> type {
+    __m512i index = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                       _mm512_set1_epi32(static_cast<int>(stride)));
+    return _mm512_i32gather_ps(index, p, 4);
+  }
+  static auto lt(type a, type b) -> mask { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static auto le(type a, type b) -> mask { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+  static auto both(mask a, mask b) -> mask { return static_cast<mask>(a & b); }
+  static auto select(mask m, type a, type b) -> type { return _mm512_mask_blend_ps(m, b, a); }
+  static auto bits(mask m) -> int { return m; }
+  static auto as_uint(type v) -> uint_type { return reinterpret_cast<uint_type>(v); }
+  static auto as_float(uint_type u) -> type { return reinterpret_cast<type>(u); }
+
+  static void load3(const float* p, type& x, type& y, type& z) {
+    __m512 a = _mm512_loadu_ps(p);
+    __m512 b = _mm512_loadu_ps(p + 16);
+    __m512 c = _mm512_loadu_ps(p + 32);
+    type* r[3] = { &x, &y, &z };
+    for (int k = 0; k < 3; ++k) {
+      __m512 ab = _mm512_permutex2var_ps(a, _mm512_load_si512(permutes.deinterleave[k][0]), b);
+      *r[k] = _mm512_permutex2var_ps(ab, _mm512_load_si512(permutes.deinterleave[k][1]), c);
+    }
+  }
+
+  static void store3(float* p, type x, type y, type z) {
+    for (int r = 0; r < 3; ++r) {
+      __m512 xy = _mm512_permutex2var_ps(x, _mm512_load_si512(permutes.interleave[r][0]), y);
+      _mm512_storeu_ps(p + 16 * r, _mm512_permutex2var_ps(xy, _mm512_load_si512(permutes.interleave[r][1]), z));
+    }
+  }
+
+  static auto broadcast4(const float* p) -> type { return _mm512_broadcast_f32x4(_mm_loadu_ps(p)); }
+
+  template <int K>
+  static auto splat(type v) -> type { return _mm512_permute_ps(v, K * 0x55); }
+
+  static auto gather4(const float* p, std::size_t stride) -> type {
+    __m512 v = _mm512_castps128_ps512(_mm_loadu_ps(p));
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(p + stride), 1);
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(p + 2 * stride), 2);
+    return _mm512_insertf32x4(v, _mm_loadu_ps(p + 3 * stride), 3);
+  }
+
+  static void scatter4(float* p, std::size_t stride, type v) {
+    _mm_storeu_ps(p, _mm512_castps512_ps128(v));
+    _mm_storeu_ps(p + stride, _mm512_extractf32x4_ps(v, 1));
+    _mm_storeu_ps(p + 2 * stride, _mm512_extractf32x4_ps(v, 2));
+    _mm_storeu_ps(p + 3 * stride, _mm512_extractf32x4_ps(v, 3));
+  }
+
+  static void transpose4(type& r0, type& r1, type& r2, type& r3) {
+    __m512 t0 = _mm512_unpacklo_ps(r0, r1);
+    __m512 t1 = _mm512_unpacklo_ps(r2, r3);
+    __m512 t2 = _mm512_unpackhi_ps(r0, r1);
+    __m512 t3 = _mm512_unpackhi_ps(r2, r3);
+    r0 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+
+  static auto singular(type det, type bound, type& inv_det) -> int {
+    __mmask16 mask = _mm512_cmp_ps_mask(_mm512_abs_ps(det), bound, _CMP_LE_OQ);
+    inv_det = _mm512_maskz_div_ps(static_cast<__mmask16>(~mask), _mm512_set1_ps(1.0F), det);
+    return mask;
+  }
+};
+#endif
+
+// widest pack of the level this file is compiled for
+#if defined(MORPHEUS_AVX512)
+using Lanes = Lanes16;
+#elif defined(MORPHEUS_AVX2)
+using Lanes = Lanes8;
+#elif defined(MORPHEUS_SSE)
+using Lanes = Lanes4;
+#else
+using Lanes = Lanes1;
+#endif
+
+// aos transforms with 4 lanes spend more on shuffles than they save on arithmetic
+#if defined(MORPHEUS_AVX2)
+using TransformLanes = Lanes;
+#else
+using TransformLanes = Lanes1;
+#endif
+
+// transforms count x, y, z triples, translation only applies to points
+template <typename P, bool Point>
+void transform_lanes(const float* m, const float* in, float* out, std::size_t count) {
+  using F = typename P::type;
+
+  // broadcast once so that stores through out can't force the compiler to reload m
+  F b[12];
+  for (int i = 0; i < 12; ++i) b[i] = P::set1(m[i]);
+
+  for (std::size_t i = 0; i + P::width <= count; i += P::width) {
+    F x, y, z;
+    P::load3(in + 3 * i, x, y, z);
+    F rx = b[0] * x + b[1] * y + b[2] * z;
+    F ry = b[4] * x + b[5] * y + b[6] * z;
+    F rz = b[8] * x + b[9] * y + b[10] * z;
+    if (Point) {
+      rx = rx + b[3];
+      ry = ry + b[7];
+      rz = rz + b[11];
+    }
+    P::store3(out + 3 * i, rx, ry, rz);
+  }
+}
+
+template <bool Point>
+void transform_aos(const float* m, const float* in, float* out, std::size_t count) {
+  std::size_t i = count - count % TransformLanes::width;
+  transform_lanes<TransformLanes, Point>(m, in, out, i);
+  transform_lanes<Lanes1, Point>(m, in + 3 * i, out + 3 * i, count - i);
+}
+
+template <typename P, bool Point>
+void transform_streams(const float* m, const float* const in[3], float* const out[3],
+                       std::size_t begin, std::size_t end) {
+  using F = typename P::type;
+
+  F b[12];
+  for (int i = 0; i < 12; ++i) b[i] = P::set1(m[i]);
+
+  for (std::size_t i = begin; i + P::width <= end; i += P::width) {
+    F x = P::load(in[0] + i);
+    F y = P::load(in[1] + i);
+    F z = P::load(in[2] + i);
+    F rx = b[0] * x + b[1] * y + b[2] * z;
+    F ry = b[4] * x + b[5] * y + b[6] * z;
+    F rz = b[8] * x + b[9] * y + b[10] * z;
+    if (Point) {
+      rx = rx + b[3];
+      ry = ry + b[7];
+      rz = rz + b[11];
+    }
+    P::store(out[0] + i, rx);
+    P::store(out[1] + i, ry);
+    P::store(out[2] + i, rz);
+  }
+}
+
+template <bool Point>
+void transform_soa(const float* m, const float* const in[3], float* const out[3], std::size_t count) {
+  std::size_t i = count - count % Lanes::width;
+  transform_streams<Lanes, Point>(m, in, out, 0, i);
+  transform_streams<Lanes1, Point>(m, in, out, i, count);
+}
+
+// padded vectors are one 128-bit lane each, so the columns of m are broadcast once
+// and every vector is a sum of its splatted components times the columns, without
+// the shuffles of load3/store3. the last row of the first three columns is zero
+// and cleared in the translation, which keeps the padding at zero
+template <typename P, bool Point>
+void transform_padded_lanes(const float* m, const float* in, float* out, std::size_t count) {
+  using F = typename P::type;
+
+  alignas(16) float t[4] = { m[12], m[13], m[14], 0.0F };
+  F c0 = P::broadcast4(m);
+  F c1 = P::broadcast4(m + 4);
+  F c2 = P::broadcast4(m + 8);
+  F c3 = P::broadcast4(t);
+
+  const std::size_t step = P::width / 4;
+  for (std::size_t i = 0; i + step <= count; i += step) {
+    F v = P::load(in + 4 * i);
+    // translation first so that points take three fused multiply-adds
+    F r = Point ? c3 + c0 * P::template splat<0>(v) : c0 * P::template splat<0>(v);
+    r = r + c1 * P::template splat<1>(v) + c2 * P::template splat<2>(v);
+    P::store(out + 4 * i, r);
+  }
+}
+
+template <bool Point>
+void transform_padded(const float* m, const float* in, float* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  i = count - count % (Lanes::width / 4);
+  transform_padded_lanes<Lanes, Point>(m, in, out, i);
+#endif
+  for (; i < count; ++i) {
+    const float* v = in + 4 * i;
+    float r[3];
+    for (int row = 0; row < 3; ++row) {
+      r[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + (Point ? m[12 + row] : 0.0F);
+    }
+    for (int row = 0; row < 3; ++row) out[4 * i + row] = r[row];
+    out[4 * i + 3] = 0.0F;
+  }
+}
+
+// composes one pair of affine transforms, 128-bit lane j of a register holds
+// column j of b and of the result. the bottom row of b is 0 or 1, so the last term
+// only adds the translation of a to the last column
+template <typename P>
+inline void compose_columns(const float* a, const float* b, float* out) {
+  using F = typename P::type;
+
+  F a0 = P::broadcast4(a);
+  F a1 = P::broadcast4(a + 4);
+  F a2 = P::broadcast4(a + 8);
+  F a3 = P::broadcast4(a + 12);
+
+  // computed before storing so that out may alias a or b
+  F r[16 / P::width];
+  for (int i = 0; i < 16 / P::width; ++i) {
+    F c = P::load(b + P::width * i);
+    r[i] = a0 * P::template splat<0>(c) + a1 * P::template splat<1>(c) + a2 * P::template splat<2>(c)
+           + a3 * P::template splat<3>(c);
+  }
+  for (int i = 0; i < 16 / P::width; ++i) P::store(out + P::width * i, r[i]);
+}
+
+inline void compose1(const float* a, const float* b, float* out) {
+  float r[12];
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      r[3 * col + row] = a[row] * b[4 * col] + a[4 + row] * b[4 * col + 1] + a[8 + row] * b[4 * col + 2];
+    }
+  }
+  for (int row = 0; row < 3; ++row) r[9 + row] += a[12 + row];
+
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 3; ++row) out[4 * col + row] = r[3 * col + row];
+    out[4 * col + 3] = col == 3 ? 1.0F : 0.0F;
+  }
+}
+
+void compose(const float* a, const float* b, float* out, std::size_t count) {
+#if defined(MORPHEUS_SSE)
+  for (std::size_t i = 0; i < count; ++i) compose_columns<Lanes>(a + 16 * i, b + 16 * i, out + 16 * i);
+#else
+  for (std::size_t i = 0; i < count; ++i) compose1(a + 16 * i, b + 16 * i, out + 16 * i);
+#endif
+}
+
+// closed-form adjugate from the 2x2 minors of the upper and lower two rows, a copy
+// of cofactor_adjugate in Matrix.hpp (which can't be used here, see above) that
+// also works on lanes, one matrix per lane.
+// m and r hold elements in column-major order, returns the determinant
+template <typename F>
+inline auto adjugate(const F* m, F* r) -> F {
+  F a0 = m[0] * m[5] - m[4] * m[1];
+  F a1 = m[0] * m[9] - m[8] * m[1];
+  F a2 = m[0] * m[13] - m[12] * m[1];
+  F a3 = m[4] * m[9] - m[8] * m[5];
+  F a4 = m[4] * m[13] - m[12] * m[5];
+  F a5 = m[8] * m[13] - m[12] * m[9];
+  F b0 = m[2] * m[7] - m[6] * m[3];
+  F b1 = m[2] * m[11] - m[10] * m[3];
+  F b2 = m[2] * m[15] - m[14] * m[3];
+  F b3 = m[6] * m[11] - m[10] * m[7];
+  F b4 = m[6] * m[15] - m[14] * m[7];
+  F b5 = m[10] * m[15] - m[14] * m[11];
+
+  r[0]  =   m[5] * b5 - m[9] * b4 + m[13] * b3;
+  r[4]  = - m[4] * b5 + m[8] * b4 - m[12] * b3;
+  r[8]  =   m[7] * a5 - m[11] * a4 + m[15] * a3;
+  r[12] = - m[6] * a5 + m[10] * a4 - m[14] * a3;
+  r[1]  = - m[1] * b5 + m[9] * b2 - m[13] * b1;
+  r[5]  =   m[0] * b5 - m[8] * b2 + m[12] * b1;
+  r[9]  = - m[3] * a5 + m[11] * a2 - m[15] * a1;
+  r[13] =   m[2] * a5 - m[10] * a2 + m[14] * a1;
+  r[2]  =   m[1] * b4 - m[5] * b2 + m[13] * b0;
+  r[6]  = - m[0] * b4 + m[4] * b2 - m[12] * b0;
+  r[10] =   m[3] * a4 - m[7] * a2 + m[15] * a0;
+  r[14] = - m[2] * a4 + m[6] * a2 - m[14] * a0;
+  r[3]  = - m[1] * b3 + m[5] * b1 - m[9] * b0;
+  r[7]  =   m[0] * b3 - m[4] * b1 + m[8] * b0;
+  r[11] = - m[3] * a3 + m[7] * a1 - m[11] * a0;
+  r[15] =   m[2] * a3 - m[6] * a1 + m[10] * a0;
+
+  return a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+}
+
+// singular_tolerance times the product of the column lengths of the n x n block of
+// the column-major 4x4 matrix m. that product bounds |det| (hadamard) and scales
+// with every column like det does, so the test doesn't depend on the units of the
+// columns. nearly dependent columns have a much smaller determinant and would give
+// inverses made of rounding errors
+template <typename P>
+inline auto singular_bound(const typename P::type* m, int n) -> typename P::type {
+  using F = typename P::type;
+  F bound = P::set1(morpheus::singular_tolerance);
+  for (int col = 0; col < n; ++col) {
+    const F* c = m + 4 * col;
+    F length2 = c[0] * c[0];
+    for (int row = 1; row < n; ++row) length2 = length2 + c[row] * c[row];
+    bound = bound * P::sqrt(length2);
+  }
+  return bound;
+}
+
+// inverts a single matrix, returns 1 if it is singular
+inline auto inverse1(const float* in, float* out) -> int {
+  float r[16];
+  float det = adjugate(in, r);
+  bool singular = (det < 0.0F ? -det : det) <= singular_bound<Lanes1>(in, 4);
+  float inv_det = singular ? 0.0F : 1.0F / det;
+  for (int i = 0; i < 16; ++i) out[i] = r[i] * inv_det;
+  return singular ? 1 : 0;
+}
+
+// inverts P::width matrices, lane p of every register belongs to matrix p.
+// returns a bit mask of the singular ones
+template <typename P>
+inline auto inverse_lanes(const float* in, float* out) -> int {
+  using F = typename P::type;
+
+  // column col of matrix i + 4j goes to 128-bit lane j of c[i]
+  F m[16];
+  for (int col = 0; col < 4; ++col) {
+    F* c = m + 4 * col;
+    for (int i = 0; i < 4; ++i) c[i] = P::gather4(in + 16 * i + 4 * col, 64);
+    P::transpose4(c[0], c[1], c[2], c[3]);
+  }
+
+  F r[16];
+  F inv_det;
+  int mask = P::singular(adjugate(m, r), singular_bound<P>(m, 4), inv_det);
+
+  for (int col = 0; col < 4; ++col) {
+    F* c = r + 4 * col;
+    for (int i = 0; i < 4; ++i) c[i] = c[i] * inv_det;
+    P::transpose4(c[0], c[1], c[2], c[3]);
+    for (int i = 0; i < 4; ++i) P::scatter4(out + 16 * i + 4 * col, 64, c[i]);
+  }
+  return mask;
+}
+
+auto inverse(const float* in, float* out, bool* singular, std::size_t count) -> std::size_t {
+  std::size_t singular_count = 0;
+
+  // writes the singular flags of a group of matrices starting at i
+  auto flag = [&](std::size_t i, int lanes, int mask) {
+    for (int lane = 0; lane < lanes; ++lane) {
+      bool s = ((mask >> lane) & 1) != 0;
+      if (singular != nullptr) singular[i + lane] = s;
+      singular_count += s ? 1 : 0;
+    }
+  };
+
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= count; i += Lanes::width) {
+    flag(i, Lanes::width, inverse_lanes<Lanes>(in + 16 * i, out + 16 * i));
+  }
+#endif
+  for (; i < count; ++i) flag(i, 1, inverse1(in + 16 * i, out + 16 * i));
+
+  return singular_count;
+}
+
+template <typename P>
+void normalize_lanes(const float* in, float* out, std::size_t begin, std::size_t end) {
+  using F = typename P::type;
+
+  for (std::size_t i = begin; i + P::width <= end; i += P::width) {
+    F x, y, z;
+    P::load3(in + 3 * i, x, y, z);
+    F length = P::sqrt(x * x + y * y + z * z);
+    P::store3(out + 3 * i, x / length, y / length, z / length);
+  }
+}
+
+void normalize(const float* in, float* out, std::size_t count) {
+  std::size_t i = count - count % Lanes::width;
+  normalize_lanes<Lanes>(in, out, 0, i);
+  normalize_lanes<Lanes1>(in, out, i, count);
+}
+
+// stores P::width packed 3x3 matrices, lane p of e[k] is element k of matrix p.
+// elements 0-3 and 4-7 are transposed back and stored 4 at a time
+template <typename P>
+inline void store_matrix3_lanes(typename P::type* e, float* m) {
+  alignas(64) float e8[P::width];
+  P::store(e8, e[8]);
+
+  P::transpose4(e[0], e[1], e[2], e[3]);
+  P::transpose4(e[4], e[5], e[6], e[7]);
+  for (int i = 0; i < 4; ++i) {
+    P::scatter4(m + 9 * i, 36, e[i]);
+    P::scatter4(m + 9 * i + 4, 36, e[i + 4]);
+  }
+  for (int p = 0; p < P::width; ++p) m[9 * p + 8] = e8[p];
+}
+
+// rotation matrix elements in column-major order from quaternion lanes
+template <typename F>
+inline void rotation_elements(F x, F y, F z, F w, F one, F* e) {
+  F x2 = x + x;
+  F y2 = y + y;
+  F z2 = z + z;
+  F xx = x * x2;
+  F yy = y * y2;
+  F zz = z * z2;
+  F xy = x * y2;
+  F xz = x * z2;
+  F yz = y * z2;
+  F wx = w * x2;
+  F wy = w * y2;
+  F wz = w * z2;
+
+  e[0] = one - (yy + zz);
+  e[1] = xy + wz;
+  e[2] = xz - wy;
+  e[3] = xy - wz;
+  e[4] = one - (xx + zz);
+  e[5] = yz + wx;
+  e[6] = xz + wy;
+  e[7] = yz - wx;
+  e[8] = one - (xx + yy);
+}
+
+// converts P::width quaternions. quaternion i + 4j goes to 128-bit lane j of the
+// i-th register, transposed so that lane p of x, y, z, w belongs to quaternion p
+template <typename P>
+inline void rotation_lanes(const float* q, float* m) {
+  using F = typename P::type;
+
+  F x = P::gather4(q, 16);
+  F y = P::gather4(q + 4, 16);
+  F z = P::gather4(q + 8, 16);
+  F w = P::gather4(q + 12, 16);
+  P::transpose4(x, y, z, w);
+
+  F e[9];
+  rotation_elements(x, y, z, w, P::set1(1.0F), e);
+  store_matrix3_lanes<P>(e, m);
+}
+
+void rotation_matrices(const float* in, float* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= count; i += Lanes::width) rotation_lanes<Lanes>(in + 4 * i, out + 9 * i);
+#endif
+  for (; i < count; ++i) {
+    const float* q = in + 4 * i;
+    rotation_elements(q[0], q[1], q[2], q[3], 1.0F, out + 9 * i);
+  }
+}
+
+// sincos(t, s, c, precision::fast) of Precision.hpp on lanes: the same
+// cody-waite reduction, polynomials and quadrant fix-up on the bits, which needs
+// no selects
+template <typename P>
+inline void sincos_lanes(typename P::type t, typename P::type& s, typename P::type& c) {
+  using F = typename P::type;
+  using U = typename P::uint_type;
+
+  F y = t * P::set1(0.636619772F) + P::set1(12582912.0F);
+  F k = y - P::set1(12582912.0F);
+  F r = ((t - k * P::set1(1.5703125F)) - k * P::set1(4.837512969970703125e-4F)) - k * P::set1(7.54978995489188216e-8F);
+
+  F z = r * r;
+  F sr = ((P::set1(-1.9515295891e-4F) * z + P::set1(8.3321608736e-3F)) * z - P::set1(1.6666654611e-1F)) * z * r + r;
+  F cr = ((P::set1(2.443315711809948e-5F) * z - P::set1(1.388731625493765e-3F)) * z + P::set1(4.166664568298827e-2F))
+         * z * z - P::set1(0.5F) * z + P::set1(1.0F);
+
+  // the quadrant is in the low bits of y, offset by 2^22 which keeps bits 0 and 1
+  U q = P::as_uint(y);
+  U sb = P::as_uint(sr);
+  U cb = P::as_uint(cr);
+  U swap = (sb ^ cb) & (0U - (q & 1U));
+  sb ^= swap ^ ((q & 2U) << 30);
+  cb ^= swap ^ (((q + 1U) & 2U) << 30);
+  s = P::as_float(sb);
+  c = P::as_float(cb);
+}
+
+template <typename P>
+void sincos_range(const float* t, float* s, float* c, std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; i += P::width) {
+    typename P::type sv;
+    typename P::type cv;
+    sincos_lanes<P>(P::load(t + i), sv, cv);
+    P::store(s + i, sv);
+    P::store(c + i, cv);
+  }
+}
+
+void sincos(const float* t, float* s, float* c, std::size_t count) {
+  std::size_t simd_end = count - count % Lanes::width;
+  sincos_range<Lanes>(t, s, c, 0, simd_end);
+  sincos_range<Lanes1>(t, s, c, simd_end, count);
+}
+
+// make_rotation_matrix elements in column-major order from lanes of sines,
+// cosines and unit axes
+template <typename F>
+inline void axis_rotation_elements(F s, F c, F ax, F ay, F az, F one, F* e) {
+  F d = one - c;
+  F x = ax * d;
+  F y = ay * d;
+  F z = az * d;
+  F axay = x * ay;
+  F axaz = x * az;
+  F ayaz = y * az;
+
+  e[0] = c + x * ax;
+  e[1] = axay + s * az;
+  e[2] = axaz - s * ay;
+  e[3] = axay - s * az;
+  e[4] = c + y * ay;
+  e[5] = ayaz + s * ax;
+  e[6] = axaz + s * ay;
+  e[7] = ayaz - s * ax;
+  e[8] = c + z * az;
+}
+
+void axis_rotation_matrices(const float* angles, const float* axes, float* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= count; i += Lanes::width) {
+    Lanes::type s;
+    Lanes::type c;
+    sincos_lanes<Lanes>(Lanes::load(angles + i), s, c);
+
+    Lanes::type x;
+    Lanes::type y;
+    Lanes::type z;
+    Lanes::load3(axes + 3 * i, x, y, z);
+
+    Lanes::type e[9];
+    axis_rotation_elements(s, c, x, y, z, Lanes::set1(1.0F), e);
+    store_matrix3_lanes<Lanes>(e, out + 9 * i);
+  }
+#endif
+  for (; i < count; ++i) {
+    float s;
+    float c;
+    sincos_lanes<Lanes1>(angles[i], s, c);
+    const float* a = axes + 3 * i;
+    axis_rotation_elements(s, c, a[0], a[1], a[2], 1.0F, out + 9 * i);
+  }
+}
+
+// inverse transpose of the upper 3x3 block of a transform with columns a, b, c:
+// the columns are b x c, c x a and a x b over the determinant. m holds the columns
+// as 4 elements each (the bottom row is ignored), e gets the elements in
+// column-major order. returns the determinant
+template <typename F>
+inline auto normal_elements(const F* m, F* e) -> F {
+  const F* a = m;
+  const F* b = m + 4;
+  const F* c = m + 8;
+
+  e[0] = b[1] * c[2] - b[2] * c[1];
+  e[1] = b[2] * c[0] - b[0] * c[2];
+  e[2] = b[0] * c[1] - b[1] * c[0];
+  e[3] = c[1] * a[2] - c[2] * a[1];
+  e[4] = c[2] * a[0] - c[0] * a[2];
+  e[5] = c[0] * a[1] - c[1] * a[0];
+  e[6] = a[1] * b[2] - a[2] * b[1];
+  e[7] = a[2] * b[0] - a[0] * b[2];
+  e[8] = a[0] * b[1] - a[1] * b[0];
+
+  return a[0] * e[0] + a[1] * e[1] + a[2] * e[2];
+}
+
+// normal matrices of P::width transforms, lane p of every register belongs to
+// transform p (gathered and transposed like in inverse_lanes)
+template <typename P>
+inline void normal_lanes(const float* in, float* out) {
+  using F = typename P::type;
+
+  F m[12];
+  for (int col = 0; col < 3; ++col) {
+    F* c = m + 4 * col;
+    for (int i = 0; i < 4; ++i) c[i] = P::gather4(in + 16 * i + 4 * col, 64);
+    P::transpose4(c[0], c[1], c[2], c[3]);
+  }
+
+  F e[9];
+  F inv_det;
+  P::singular(normal_elements(m, e), singular_bound<P>(m, 3), inv_det);
+  for (int k = 0; k < 9; ++k) e[k] = e[k] * inv_det;
+  store_matrix3_lanes<P>(e, out);
+}
+
+void normal_matrices(const float* in, float* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= count; i += Lanes::width) normal_lanes<Lanes>(in + 16 * i, out + 9 * i);
+#endif
+  for (; i < count; ++i) {
+    float* e = out + 9 * i;
+    float det = normal_elements(in + 16 * i, e);
+    float inv_det = (det < 0.0F ? -det : det) <= singular_bound<Lanes1>(in + 16 * i, 3) ? 0.0F : 1.0F / det;
+    for (int k = 0; k < 9; ++k) e[k] *= inv_det;
+  }
+}
+
+// boxes of P::width aabbs (min x, y, z, max x, y, z) against 6 planes (nx, ny, nz,
+// offset), lane p of every register belongs to box p. a box is outside of a plane
+// when its center is further outside than its extent projected on the normal
+// reaches, n . c + offset + |n| . e < 0. returns the bit mask of the boxes outside
+// of any plane
+template <typename P>
+inline auto outside_lanes(const float* planes, const float* boxes) -> int {
+  using F = typename P::type;
+
+  F half = P::set1(0.5F);
+  F c[3];
+  F e[3];
+  for (int k = 0; k < 3; ++k) {
+    F lo = P::load_strided(boxes + k, 6);
+    F hi = P::load_strided(boxes + 3 + k, 6);
+    c[k] = (lo + hi) * half;
+    e[k] = (hi - lo) * half;
+  }
+
+  int outside = 0;
+  for (int i = 0; i < 6; ++i) {
+    const float* n = planes + 4 * i;
+    F d = c[0] * P::set1(n[0]) + c[1] * P::set1(n[1]) + c[2] * P::set1(n[2]) + P::set1(n[3]);
+    F r = e[0] * P::set1(__builtin_fabsf(n[0])) + e[1] * P::set1(__builtin_fabsf(n[1])) +
+          e[2] * P::set1(__builtin_fabsf(n[2]));
+    outside |= P::bits(P::lt(d + r, P::set1(0.0F)));
+  }
+  return outside;
+}
+
+// bits of mask to bools, 8 at a time: the multiply copies the byte to all 8 bytes,
+// the and keeps bit j in byte j and adding 0x7f moves any set bit to bit 7
+inline void store_bools(int mask, bool* out, int width) {
+  for (int j = 0; j < width; j += 8) {
+    std::uint64_t bits = static_cast<std::uint64_t>((mask >> j) & 0xff) * 0x0101010101010101ULL;
+    std::uint64_t bytes = (((bits & 0x8040201008040201ULL) + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;
+    std::memcpy(out + j, &bytes, static_cast<std::size_t>(width - j < 8 ? width - j : 8));
+  }
+}
+
+auto intersect_boxes(const float* planes, const float* boxes, bool* visible, std::size_t count) -> std::size_t {
+  std::size_t n = 0;
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= count; i += Lanes::width) {
+    int outside = outside_lanes<Lanes>(planes, boxes + 6 * i);
+    store_bools(~outside, visible + i, Lanes::width);
+    n += Lanes::width - static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned int>(outside)));
+  }
+#endif
+  for (; i < count; ++i) {
+    visible[i] = outside_lanes<Lanes1>(planes, boxes + 6 * i) == 0;
+    n += visible[i] ? 1 : 0;
+  }
+  return n;
+}
+
+// ray/triangle tests (moller and trumbore 1997) like intersect(Ray, Triangle) in
+// the geometry library. triangles are given as vertex a and edges e1 = b - a,
+// e2 = c - a, rays as origin o and direction d, all as x, y, z registers. returns
+// the lanes that hit in [0, t_best), with the parameter t and the barycentric
+// coordinates u, v of b and c
+template <typename F>
+inline void cross_elements(const F* a, const F* b, F* r) {
+  r[0] = a[1] * b[2] - a[2] * b[1];
+  r[1] = a[2] * b[0] - a[0] * b[2];
+  r[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+template <typename F>
+inline auto dot_elements(const F* a, const F* b) -> F {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+template <typename P>
+inline auto triangle_hits(const typename P::type* o, const typename P::type* d, const typename P::type* a,
+                          const typename P::type* e1, const typename P::type* e2, typename P::type t_best,
+                          typename P::type& t, typename P::type& u, typename P::type& v) -> typename P::mask {
+  using F = typename P::type;
+
+  F p[3];
+  cross_elements(d, e2, p);
+  F inv_det = P::set1(1.0F) / dot_elements(e1, p);
+
+  F s[3] = { o[0] - a[0], o[1] - a[1], o[2] - a[2] };
+  u = dot_elements(s, p) * inv_det;
+  F q[3];
+  cross_elements(s, e1, q);
+  v = dot_elements(d, q) * inv_det;
+  t = dot_elements(e2, q) * inv_det;
+
+  F zero = P::set1(0.0F);
+  typename P::mask m = P::both(P::le(zero, u), P::le(zero, v));
+  m = P::both(m, P::le(u + v, P::set1(1.0F)));
+  return P::both(m, P::both(P::le(zero, t), P::lt(t, t_best)));
+}
+
+// one ray against P::width triangles per iteration from triangle i on, lane j
+// holds triangle i + j. hits are rare, so the nearest one is kept in scalars and
+// lanes are only looked at when one of them is nearer. returns the first triangle
+// not tested
+template <typename P>
+inline auto nearest_triangle(const float* ray, const float* const tri[9], std::size_t i, std::size_t count,
+                             float* hit, std::uint32_t& index) -> std::size_t {
+  using F = typename P::type;
+
+  F o[3];
+  F d[3];
+  for (int k = 0; k < 3; ++k) {
+    o[k] = P::set1(ray[k]);
+    d[k] = P::set1(ray[3 + k]);
+  }
+
+  for (; i + P::width <= count; i += P::width) {
+    F v[9];
+    for (int k = 0; k < 9; ++k) v[k] = P::load(tri[k] + i);
+
+    F t;
+    F u;
+    F w;
+    int m = P::bits(triangle_hits<P>(o, d, v, v + 3, v + 6, P::set1(hit[0]), t, u, w));
+    if (m == 0) continue;
+
+    float ts[P::width];
+    float us[P::width];
+    float ws[P::width];
+    P::store(ts, t);
+    P::store(us, u);
+    P::store(ws, w);
+    for (int j = 0; j < P::width; ++j) {
+      if ((m & (1 << j)) != 0 && ts[j] < hit[0]) {
+        hit[0] = ts[j];
+        hit[1] = us[j];
+        hit[2] = ws[j];
+        index = static_cast<std::uint32_t>(i + j);
+      }
+    }
+  }
+  return i;
+}
+
+// hits are t, u, v and the bits of the uint32 triangle index, RayHit::none
+// (all ones) if the ray misses
+void intersect_triangles(const float* ray, const float* const tri[9], std::size_t count, float t_max, float* hit) {
+  std::uint32_t index = 0xffffffff;
+  hit[0] = t_max;
+  hit[1] = 0.0F;
+  hit[2] = 0.0F;
+
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  i = nearest_triangle<Lanes>(ray, tri, i, count, hit, index);
+#endif
+  nearest_triangle<Lanes1>(ray, tri, i, count, hit, index);
+  std::memcpy(hit + 3, &index, sizeof(index));
+}
+
+#if defined(MORPHEUS_SSE)
+// P::width rays, lane j holds ray j, against every triangle in turn. the nearest
+// hit of each lane is kept with selects, including the index as float bits
+template <typename P>
+inline void ray_packet(const float* rays, const float* const tri[9], std::size_t count, float t_max, float* hits) {
+  using F = typename P::type;
+
+  F o[3];
+  F d[3];
+  for (int k = 0; k < 3; ++k) {
+    o[k] = P::load_strided(rays + k, 6);
+    d[k] = P::load_strided(rays + 3 + k, 6);
+  }
+
+  std::uint32_t none = 0xffffffff;
+  float none_bits;
+  std::memcpy(&none_bits, &none, sizeof(none_bits));
+
+  F t_best = P::set1(t_max);
+  F u_best = P::set1(0.0F);
+  F v_best = P::set1(0.0F);
+  F index = P::set1(none_bits);
+  for (std::size_t i = 0; i < count; ++i) {
+    F v[9];
+    for (int k = 0; k < 9; ++k) v[k] = P::set1(tri[k][i]);
+
+    F t;
+    F u;
+    F w;
+    typename P::mask m = triangle_hits<P>(o, d, v, v + 3, v + 6, t_best, t, u, w);
+
+    std::uint32_t j = static_cast<std::uint32_t>(i);
+    float j_bits;
+    std::memcpy(&j_bits, &j, sizeof(j_bits));
+    t_best = P::select(m, t, t_best);
+    u_best = P::select(m, u, u_best);
+    v_best = P::select(m, w, v_best);
+    index = P::select(m, P::set1(j_bits), index);
+  }
+
+  // t, u, v, index quadruples: after the transpose register k holds the hits of
+  // rays k, k + 4, ... in its 128-bit lanes
+  P::transpose4(t_best, u_best, v_best, index);
+  P::scatter4(hits, 16, t_best);
+  P::scatter4(hits + 4, 16, u_best);
+  P::scatter4(hits + 8, 16, v_best);
+  P::scatter4(hits + 12, 16, index);
+}
+#endif
+
+void intersect_rays(const float* rays, std::size_t ray_count, const float* const tri[9], std::size_t count,
+                    float t_max, float* hits) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_SSE)
+  for (; i + Lanes::width <= ray_count; i += Lanes::width) {
+    ray_packet<Lanes>(rays + 6 * i, tri, count, t_max, hits + 4 * i);
+  }
+#endif
+  for (; i < ray_count; ++i) intersect_triangles(rays + 6 * i, tri, count, t_max, hits + 4 * i);
+}
+
+// scalar conversions for levels without f16c, the same bit manipulations as in
+// Half.hpp (which can't be used here, see above)
+inline auto to_half1(float f) -> std::uint16_t {
+  std::uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  std::uint32_t sign = (u >> 16) & 0x8000;
+  u &= 0x7fffffff;
+
+  std::uint32_t h;
+  if (u >= 0x47800000) {
+    h = u > 0x7f800000 ? 0x7e00 | ((u >> 13) & 0x3ff) : 0x7c00;
+  } else if (u < 0x38800000) {
+    float g;
+    std::memcpy(&g, &u, sizeof(g));
+    g += 0.5F;
+    std::memcpy(&h, &g, sizeof(h));
+    h -= 0x3f000000;
+  } else {
+    std::uint32_t odd = (u >> 13) & 1;
+    h = (u - ((127 - 15) << 23) + 0xfff + odd) >> 13;
+  }
+  return static_cast<std::uint16_t>(h | sign);
+}
+
+inline auto to_float1(std::uint16_t h) -> float {
+  std::uint32_t u = static_cast<std::uint32_t>(h & 0x7fff) << 13;
+  std::uint32_t exponent = u & 0x0f800000;
+  u += (127 - 15) << 23;
+
+  float f;
+  if (exponent == 0x0f800000) {
+    u += (128 - 16) << 23;
+    if ((u & 0x7fffff) != 0) u |= 0x400000;
+    std::memcpy(&f, &u, sizeof(f));
+  } else if (exponent == 0) {
+    u += 1 << 23;
+    std::memcpy(&f, &u, sizeof(f));
+    f -= 6.103515625e-05F;
+  } else {
+    std::memcpy(&f, &u, sizeof(f));
+  }
+
+  std::uint32_t r;
+  std::memcpy(&r, &f, sizeof(r));
+  r |= static_cast<std::uint32_t>(h & 0x8000) << 16;
+  std::memcpy(&f, &r, sizeof(f));
+  return f;
+}
+
+// f16c is part of x86-64-v3, so the avx2 and avx512 levels convert 8 or 16
+// elements per instruction and the lower levels fall back to the bits
+void to_half(const float* in, std::uint16_t* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_AVX512)
+  for (; i + 16 <= count; i += 16) {
+    __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), h);
+  }
+#endif
+#if defined(MORPHEUS_F16C)
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+  }
+#endif
+  for (; i < count; ++i) out[i] = to_half1(in[i]);
+}
+
+void to_float(const std::uint16_t* in, float* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(MORPHEUS_AVX512)
+  for (; i + 16 <= count; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+  }
+#endif
+#if defined(MORPHEUS_F16C)
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < count; ++i) out[i] = to_float1(in[i]);
+}
+
+}  // namespace
+
+namespace morpheus {
+namespace MORPHEUS_KERNEL_LEVEL {
+
+auto get_batch_kernels() -> BatchKernels {
+  BatchKernels kernels;
+  kernels.transform_points = transform_aos<true>;
+  kernels.transform_vectors = transform_aos<false>;
+  kernels.transform_points_soa = transform_soa<true>;
+  kernels.transform_vectors_soa = transform_soa<false>;
+  kernels.transform_points_padded = transform_padded<true>;
+  kernels.transform_vectors_padded = transform_padded<false>;
+  kernels.compose = compose;
+  kernels.inverse = inverse;
+  kernels.normalize = normalize;
+  kernels.rotation_matrices = rotation_matrices;
+  kernels.axis_rotation_matrices = axis_rotation_matrices;
+  kernels.normal_matrices = normal_matrices;
+  kernels.sincos = sincos;
+  kernels.intersect_boxes = intersect_boxes;
+  kernels.intersect_triangles = intersect_triangles;
+  kernels.intersect_rays = intersect_rays;
+  kernels.to_half = to_half;
+  kernels.to_float = to_float;
+  return kernels;
+}
+
+}  // namespace MORPHEUS_KERNEL_LEVEL
+}  // namespace morpheus
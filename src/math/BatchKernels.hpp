@@ -0,0 +1,86 @@
+#ifndef MORPHEUS_BATCH_KERNELS_HPP
+#define MORPHEUS_BATCH_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// table of the batch kernels behind transform_points/vectors, compose_batch,
+// inverse_batch, normalize_batch, sincos_batch, make_rotation_matrices,
+// get_rotation_matrices, get_normal_matrices, the half conversions and the
+// frustum culling and ray/triangle tests of the geometry library.
+// BatchKernels.cpp is compiled once per instruction set level, each copy fills a
+// table in its own namespace and Dispatch.cpp picks one at runtime (see
+// Dispatch.hpp).
+// kernels take raw floats so that they don't depend on the library headers
+
+namespace morpheus {
+
+// matrices whose determinant is at most this fraction of the product of their
+// column lengths count as singular (see inverse_batch and get_normal_matrix)
+const float singular_tolerance = 1e-6F;
+
+struct BatchKernels {
+  // m is the 3x4 affine part of a transform in row-major order, aos arrays hold
+  // tightly packed x, y, z triples, out may alias in
+  void (*transform_points)(const float* m, const float* in, float* out, std::size_t count);
+  void (*transform_vectors)(const float* m, const float* in, float* out, std::size_t count);
+  void (*transform_points_soa)(const float* m, const float* const in[3], float* const out[3], std::size_t count);
+  void (*transform_vectors_soa)(const float* m, const float* const in[3], float* const out[3], std::size_t count);
+
+  // m is a 16-byte aligned column-major 4x4 transform, arrays hold 16-byte aligned
+  // x, y, z, pad quadruples (Vector3A), out gets zero padding and may alias in
+  void (*transform_points_padded)(const float* m, const float* in, float* out, std::size_t count);
+  void (*transform_vectors_padded)(const float* m, const float* in, float* out, std::size_t count);
+
+  // 16-byte aligned column-major 4x4 matrices with a bottom row of 0, 0, 0, 1,
+  // out may alias a or b
+  void (*compose)(const float* a, const float* b, float* out, std::size_t count);
+
+  // 16-byte aligned column-major 4x4 matrices, singular may be null, returns the
+  // number of singular matrices (see inverse_batch in Matrix4.hpp)
+  std::size_t (*inverse)(const float* in, float* out, bool* singular, std::size_t count);
+
+  // aos x, y, z triples
+  void (*normalize)(const float* in, float* out, std::size_t count);
+
+  // x, y, z, w quaternions to packed column-major 3x3 matrices
+  void (*rotation_matrices)(const float* in, float* out, std::size_t count);
+
+  // angles and packed x, y, z unit axes to packed column-major 3x3 matrices, with
+  // the polynomial sine and cosine below
+  void (*axis_rotation_matrices)(const float* angles, const float* axes, float* out, std::size_t count);
+
+  // sines and cosines with the polynomials of precision::fast (see Precision.hpp)
+  void (*sincos)(const float* t, float* s, float* c, std::size_t count);
+
+  // 16-byte aligned column-major 4x4 matrices to packed column-major inverse
+  // transposes of their upper 3x3 blocks, zero for singular blocks
+  void (*normal_matrices)(const float* in, float* out, std::size_t count);
+
+  // planes are 6 packed nx, ny, nz, offset quadruples and boxes packed min x, y, z,
+  // max x, y, z sextuples. visible[i] tells whether box i is on the inner side of,
+  // or intersects, every plane, returns the number of visible boxes
+  std::size_t (*intersect_boxes)(const float* planes, const float* boxes, bool* visible, std::size_t count);
+
+  // ray is an origin and a direction as 6 floats, triangles are the 9 streams of
+  // vertex a and edges b - a, c - a (see TriangleStreams). hit gets t, u, v and the
+  // bits of a uint32 triangle index (all ones for none) of the nearest hit in
+  // [0, t_max). rays are packed rays and hits packed hits
+  void (*intersect_triangles)(const float* ray, const float* const triangles[9], std::size_t count, float t_max,
+                              float* hit);
+  void (*intersect_rays)(const float* rays, std::size_t ray_count, const float* const triangles[9],
+                         std::size_t count, float t_max, float* hits);
+
+  // floats to ieee binary16 bits and back, rounding to nearest even (see Half.hpp)
+  void (*to_half)(const float* in, std::uint16_t* out, std::size_t count);
+  void (*to_float)(const std::uint16_t* in, float* out, std::size_t count);
+};
+
+namespace scalar { auto get_batch_kernels() -> BatchKernels; }
+namespace sse4_2 { auto get_batch_kernels() -> BatchKernels; }
+namespace avx2 { auto get_batch_kernels() -> BatchKernels; }
+namespace avx512 { auto get_batch_kernels() -> BatchKernels; }
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_BATCH_KERNELS_HPP
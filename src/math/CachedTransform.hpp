@@ -0,0 +1,78 @@
+#ifndef MORPHEUS_CACHED_TRANSFORM_HPP
+#define MORPHEUS_CACHED_TRANSFORM_HPP
+
+#include "Matrix3.hpp"
+#include "Point3.hpp"
+#include "RigidTransform.hpp"
+#include "Transform4.hpp"
+#include "Vector3.hpp"
+
+namespace morpheus {
+
+// transform of a scene object that keeps its normal matrix (see get_normal_matrix)
+// until the upper 3x3 block changes, so that static objects don't recompute it
+// every draw. set from a RigidTransform the normal matrix is the rotation itself
+// and no inverse is computed.
+// writes to the 3x3 block through set_column invalidate the cache, translations
+// don't affect it and reads are free. a separate type rather than members of
+// Transform4, which the batched kernels expect to be 16 packed floats
+class CachedTransform {
+ private:
+  Transform4 h_;
+  mutable Matrix3 normal_;
+  mutable bool dirty_{false};
+  bool rigid_{true};
+
+ public:
+  CachedTransform()
+      : h_(Vector3(1.0F, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F), Vector3(0.0F, 0.0F, 1.0F), Point3(0.0F, 0.0F, 0.0F)),
+        normal_{Vector3(1.0F, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F), Vector3(0.0F, 0.0F, 1.0F)} {}
+  explicit CachedTransform(const Transform4& h) : h_(h), dirty_(true), rigid_(false) {}
+  explicit CachedTransform(const RigidTransform& h) : h_(h.get_transform()), dirty_(true), rigid_(true) {}
+
+  auto get_transform() const -> const Transform4& { return h_; }
+  operator const Transform4&() const { return h_; }
+
+  void set_transform(const Transform4& h) {
+    h_ = h;
+    dirty_ = true;
+    rigid_ = false;
+  }
+
+  void set_transform(const RigidTransform& h) {
+    h_ = h.get_transform();
+    dirty_ = true;
+    rigid_ = true;
+  }
+
+  // false once the 3x3 block was written directly or set from a general transform
+  auto is_rigid() const -> bool { return rigid_; }
+
+  auto operator[](int j) const -> const Vector3& { return h_[j]; }
+
+  // column j of the 3x3 block, or the translation for j = 3, which keeps the cache
+  void set_column(int j, const Vector3& v) {
+    h_[j] = v;
+    if (j < 3) {
+      dirty_ = true;
+      rigid_ = false;
+    }
+  }
+
+  auto get_translation() const -> const Point3& { return h_.get_translation(); }
+  void set_translation(const Point3& p) { h_.set_translation(p); }
+
+  auto get_normal_matrix() const -> const Matrix3& {
+    if (dirty_) {
+      normal_ = rigid_ ? Matrix3{h_[0], h_[1], h_[2]} : morpheus::get_normal_matrix(h_);
+      dirty_ = false;
+    }
+    return normal_;
+  }
+};
+
+inline auto get_normal_matrix(const CachedTransform& h) -> const Matrix3& { return h.get_normal_matrix(); }
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_CACHED_TRANSFORM_HPP
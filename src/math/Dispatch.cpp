@@ -0,0 +1,88 @@
+#include "Dispatch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "BatchKernels.hpp"
+
+namespace {
+
+using morpheus::BatchKernels;
+using morpheus::SimdLevel;
+
+const int level_count = 4;
+
+// MORPHEUS_DISPATCH is defined when BatchKernels.cpp is compiled for every level,
+// otherwise only the scalar kernels exist
+auto detect() -> SimdLevel {
+#if defined(MORPHEUS_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("x86-64-v4")) return SimdLevel::avx512;
+  if (__builtin_cpu_supports("x86-64-v3")) return SimdLevel::avx2;
+  if (__builtin_cpu_supports("x86-64-v2")) return SimdLevel::sse4_2;
+#endif
+  return SimdLevel::scalar;
+}
+
+auto get_tables() -> const BatchKernels* {
+  static const BatchKernels tables[level_count] = {
+    morpheus::scalar::get_batch_kernels(),
+#if defined(MORPHEUS_DISPATCH)
+    morpheus::sse4_2::get_batch_kernels(),
+    morpheus::avx2::get_batch_kernels(),
+    morpheus::avx512::get_batch_kernels(),
+#endif
+  };
+  return tables;
+}
+
+auto clamp(SimdLevel level) -> SimdLevel {
+  SimdLevel supported = morpheus::get_supported_simd_level();
+  return static_cast<int>(level) < static_cast<int>(supported) ? level : supported;
+}
+
+auto initial_level() -> SimdLevel {
+  const char* name = std::getenv("MORPHEUS_SIMD_LEVEL");
+  for (int i = 0; name != nullptr && i < level_count; ++i) {
+    SimdLevel level = static_cast<SimdLevel>(i);
+    if (std::strcmp(name, to_string(level)) == 0) return clamp(level);
+  }
+  return morpheus::get_supported_simd_level();
+}
+
+auto active_level() -> std::atomic<SimdLevel>& {
+  static std::atomic<SimdLevel> level{initial_level()};
+  return level;
+}
+
+}  // namespace
+
+auto morpheus::to_string(SimdLevel level) -> const char* {
+  switch (level) {
+    case SimdLevel::scalar: return "scalar";
+    case SimdLevel::sse4_2: return "sse4_2";
+    case SimdLevel::avx2: return "avx2";
+    case SimdLevel::avx512: return "avx512";
+  }
+  return "unknown";
+}
+
+auto morpheus::get_supported_simd_level() -> SimdLevel {
+  static const SimdLevel supported = detect();
+  return supported;
+}
+
+auto morpheus::get_simd_level() -> SimdLevel {
+  return active_level().load(std::memory_order_relaxed);
+}
+
+auto morpheus::set_simd_level(SimdLevel level) -> SimdLevel {
+  level = clamp(level);
+  active_level().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+auto morpheus::get_batch_kernels() -> const BatchKernels& {
+  return get_tables()[static_cast<int>(get_simd_level())];
+}
@@ -0,0 +1,30 @@
+#ifndef MORPHEUS_DISPATCH_HPP
+#define MORPHEUS_DISPATCH_HPP
+
+#include "BatchKernels.hpp"
+
+namespace morpheus {
+
+// instruction set levels the batch kernels are compiled for, in increasing order
+// (x86-64 microarchitecture levels v2, v3 and v4). the best level supported by
+// the cpu is selected on first use, unless the MORPHEUS_SIMD_LEVEL environment
+// variable names a lower one (e.g. MORPHEUS_SIMD_LEVEL=sse4_2)
+enum class SimdLevel { scalar, sse4_2, avx2, avx512 };
+
+auto to_string(SimdLevel level) -> const char*;
+
+// best level supported by both the cpu and the build
+auto get_supported_simd_level() -> SimdLevel;
+
+auto get_simd_level() -> SimdLevel;
+
+// forces the kernels of a given level (for benchmarks and a/b checks), clamped
+// to the supported level. returns the level actually set
+auto set_simd_level(SimdLevel level) -> SimdLevel;
+
+// kernels of the current level
+auto get_batch_kernels() -> const BatchKernels&;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_DISPATCH_HPP
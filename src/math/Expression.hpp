@@ -0,0 +1,241 @@
+#ifndef MORPHEUS_EXPRESSION_HPP
+#define MORPHEUS_EXPRESSION_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "Span.hpp"
+
+// lazily evaluated component-wise vector arithmetic (expression templates).
+// a + b * s builds a tree of light-weight nodes that is evaluated in a single
+// pass, without temporaries, when it is assigned to or used to construct a vector.
+// nodes hold vectors by reference, so an expression must not outlive the full
+// expression it was created in (don't store it in an auto variable)
+
+namespace morpheus {
+
+// describes how a type takes part in vector expressions, specialized next to every
+// vector type and node. size is the number of components (0 for runtime-sized
+// arrays), value_type the scalar type of the components, result is the type the
+// expression evaluates to and operand how nodes store the type
+template <typename T>
+struct expression_traits {
+  static const bool value = false;
+  static const std::size_t size = 0;
+  using value_type = void;
+  using result = void;
+};
+
+template <>
+struct expression_traits<span<const float>> {
+  static const bool value = true;
+  static const std::size_t size = 0;
+  using value_type = float;
+  using result = void;
+  using operand = span<const float>;
+};
+
+template <>
+struct expression_traits<span<float>> {
+  static const bool value = true;
+  static const std::size_t size = 0;
+  using value_type = float;
+  using result = void;
+  using operand = span<const float>;
+};
+
+// result types of mixed expressions, specialized for points (see Point3.hpp). a
+// specialization without type makes the operation ill-formed
+template <typename A, typename B>
+struct sum_result {
+  using type = A;
+};
+
+template <typename A, typename B>
+struct difference_result {
+  using type = A;
+};
+
+template <typename A>
+struct scaled_result {
+  using type = A;
+};
+
+template <typename E>
+using expression_result = typename expression_traits<E>::result;
+
+template <typename E>
+using expression_value = typename expression_traits<E>::value_type;
+
+// scalar type that an expression can be multiplied or divided by
+template <typename E>
+using expression_scalar = typename std::enable_if<expression_traits<E>::value, expression_value<E>>::type;
+
+template <typename L, typename R>
+struct are_compatible_expressions {
+  static const bool value = expression_traits<L>::value && expression_traits<R>::value
+                            && expression_traits<L>::size == expression_traits<R>::size
+                            && std::is_same<expression_value<L>, expression_value<R>>::value;
+};
+
+// true if the sum of L and R has a result type
+template <typename L, typename R, typename = void>
+struct has_sum_result : std::false_type {};
+
+template <typename L, typename R>
+struct has_sum_result<L, R, std::void_t<typename sum_result<expression_result<L>, expression_result<R>>::type>>
+    : std::true_type {};
+
+// true if E is an expression of size components that evaluates to one of the results
+template <typename E, std::size_t size, typename... Results>
+struct is_expression_of;
+
+template <typename E, std::size_t size>
+struct is_expression_of<E, size> {
+  static const bool value = false;
+};
+
+template <typename E, std::size_t size, typename Result, typename... Results>
+struct is_expression_of<E, size, Result, Results...> {
+  static const bool value = (expression_traits<E>::value && expression_traits<E>::size == size
+                             && std::is_same<expression_result<E>, Result>::value)
+                            || is_expression_of<E, size, Results...>::value;
+};
+
+struct Add {
+  template <typename T>
+  static constexpr auto apply(const T& a, const T& b) -> T { return a + b; }
+};
+
+struct Subtract {
+  template <typename T>
+  static constexpr auto apply(const T& a, const T& b) -> T { return a - b; }
+};
+
+struct Multiply {
+  template <typename T>
+  static constexpr auto apply(const T& a, const T& b) -> T { return a * b; }
+};
+
+struct Divide {
+  template <typename T>
+  static constexpr auto apply(const T& a, const T& b) -> T { return a / b; }
+};
+
+// component-wise op applied to two expressions
+template <typename Op, typename L, typename R>
+class BinaryExpression {
+ private:
+  typename expression_traits<L>::operand l_;
+  typename expression_traits<R>::operand r_;
+
+ public:
+  constexpr BinaryExpression(const L& l, const R& r) : l_(l), r_(r) {}
+
+  constexpr auto operator[](std::size_t i) const -> expression_value<L> { return Op::apply(l_[i], r_[i]); }
+};
+
+// op applied to every component of an expression and a scalar
+template <typename Op, typename E>
+class ScalarExpression {
+ private:
+  typename expression_traits<E>::operand e_;
+  expression_value<E> s_;
+
+ public:
+  constexpr ScalarExpression(const E& e, expression_value<E> s) : e_(e), s_(s) {}
+
+  constexpr auto operator[](std::size_t i) const -> expression_value<E> { return Op::apply(e_[i], s_); }
+};
+
+template <typename E>
+class NegateExpression {
+ private:
+  typename expression_traits<E>::operand e_;
+
+ public:
+  constexpr explicit NegateExpression(const E& e) : e_(e) {}
+
+  constexpr auto operator[](std::size_t i) const -> expression_value<E> { return -e_[i]; }
+};
+
+template <typename L, typename R>
+struct expression_traits<BinaryExpression<Add, L, R>> {
+  static const bool value = true;
+  static const std::size_t size = expression_traits<L>::size;
+  using value_type = expression_value<L>;
+  using result = typename sum_result<expression_result<L>, expression_result<R>>::type;
+  using operand = BinaryExpression<Add, L, R>;
+};
+
+template <typename L, typename R>
+struct expression_traits<BinaryExpression<Subtract, L, R>> {
+  static const bool value = true;
+  static const std::size_t size = expression_traits<L>::size;
+  using value_type = expression_value<L>;
+  using result = typename difference_result<expression_result<L>, expression_result<R>>::type;
+  using operand = BinaryExpression<Subtract, L, R>;
+};
+
+template <typename Op, typename E>
+struct expression_traits<ScalarExpression<Op, E>> {
+  static const bool value = true;
+  static const std::size_t size = expression_traits<E>::size;
+  using value_type = expression_value<E>;
+  using result = typename scaled_result<expression_result<E>>::type;
+  using operand = ScalarExpression<Op, E>;
+};
+
+template <typename E>
+struct expression_traits<NegateExpression<E>> {
+  static const bool value = true;
+  static const std::size_t size = expression_traits<E>::size;
+  using value_type = expression_value<E>;
+  using result = typename scaled_result<expression_result<E>>::type;
+  using operand = NegateExpression<E>;
+};
+
+template <typename L, typename R>
+constexpr auto operator+(const L& l, const R& r)
+    -> typename std::enable_if<are_compatible_expressions<L, R>::value && has_sum_result<L, R>::value,
+                               BinaryExpression<Add, L, R>>::type {
+  return {l, r};
+}
+
+template <typename L, typename R>
+constexpr auto operator-(const L& l, const R& r)
+    -> typename std::enable_if<are_compatible_expressions<L, R>::value, BinaryExpression<Subtract, L, R>>::type {
+  return {l, r};
+}
+
+template <typename E>
+constexpr auto operator*(const E& e, expression_scalar<E> s)
+    -> typename std::enable_if<expression_traits<E>::value, ScalarExpression<Multiply, E>>::type {
+  return {e, s};
+}
+
+template <typename E>
+constexpr auto operator/(const E& e, expression_scalar<E> s)
+    -> typename std::enable_if<expression_traits<E>::value, ScalarExpression<Divide, E>>::type {
+  assert(s != expression_scalar<E>(0));
+  return {e, s};
+}
+
+template <typename E>
+constexpr auto operator-(const E& e)
+    -> typename std::enable_if<expression_traits<E>::value, NegateExpression<E>>::type {
+  return NegateExpression<E>(e);
+}
+
+// evaluates an expression over runtime-sized arrays (e.g. one component of a
+// structure-of-arrays stream) in a single pass, out may alias the operands
+template <typename E>
+auto assign(span<float> out, const E& e)
+    -> typename std::enable_if<expression_traits<E>::value && expression_traits<E>::size == 0>::type {
+  for (std::size_t i = 0; i < out.size(); ++i) out[i] = e[i];
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_EXPRESSION_HPP
@@ -0,0 +1,122 @@
+#ifndef MORPHEUS_FIXED_HPP
+#define MORPHEUS_FIXED_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace morpheus {
+
+// signed fixed-point number stored in 32 bits, the low fraction_bits of which are
+// the fractional part. conversions round to nearest with ties away from zero and
+// assert the range, checked_convert reports it instead. products and quotients are
+// computed in 64 bits and rounded to nearest, with ties up (towards +infinity) for
+// products and away from zero for quotients. all arithmetic wraps modulo 2^32 on
+// overflow (sums, differences and negation in unsigned arithmetic, products and
+// quotients when narrowed from 64 bits, which gcc and clang do modulo 2^32).
+// usable as the scalar type of Vector and Matrix (e.g. Vector<Fixed<16>, 3>)
+template <int FractionBits>
+class Fixed {
+  static_assert(FractionBits > 0 && FractionBits < 31, "fraction bits must leave room for the sign and integer part");
+
+ private:
+  std::int32_t raw_{0};
+
+  // d * one rounded half away from zero (std::lround is not constexpr), false if
+  // that doesn't fit in 32 bits or d is nan. floats convert exactly to double
+  static constexpr auto convert(double d, std::int32_t& raw) -> bool {
+    double r = d < 0 ? d * one - 0.5 : d * one + 0.5;
+    if (!(r > -2147483649.0 && r < 2147483648.0)) return false;
+    raw = static_cast<std::int32_t>(r);
+    return true;
+  }
+
+  static constexpr auto convert(double d) -> std::int32_t {
+    std::int32_t raw = 0;
+    bool fits = convert(d, raw);
+    assert(fits);
+    (void)fits;
+    return raw;
+  }
+
+  // the signed value of the low 32 bits of u, modulo 2^32 in gcc and clang
+  static constexpr auto wrap(std::uint32_t u) -> std::int32_t { return static_cast<std::int32_t>(u); }
+
+  static constexpr auto convert(int i) -> std::int32_t {
+    assert(i >= std::numeric_limits<std::int32_t>::min() / one && i <= std::numeric_limits<std::int32_t>::max() / one);
+    return i * one;
+  }
+
+ public:
+  static const int fraction_bits = FractionBits;
+  static const std::int32_t one = std::int32_t(1) << FractionBits;
+
+  Fixed() = default;
+  constexpr explicit Fixed(int i) : raw_(convert(i)) {}
+  constexpr explicit Fixed(float f) : raw_(convert(static_cast<double>(f))) {}
+  constexpr explicit Fixed(double d) : raw_(convert(d)) {}
+
+  // d rounded like the constructors, false if it is out of range or nan
+  static constexpr auto checked_convert(double d, Fixed& out) -> bool { return convert(d, out.raw_); }
+
+  static constexpr auto from_raw(std::int32_t raw) -> Fixed {
+    Fixed f;
+    f.raw_ = raw;
+    return f;
+  }
+
+  constexpr auto raw() const -> std::int32_t { return raw_; }
+
+  constexpr explicit operator float() const { return static_cast<float>(raw_) / one; }
+  constexpr explicit operator double() const { return static_cast<double>(raw_) / one; }
+
+  constexpr auto operator-() const -> Fixed { return from_raw(wrap(0u - static_cast<std::uint32_t>(raw_))); }
+
+  constexpr auto operator+=(Fixed f) -> Fixed& {
+    raw_ = wrap(static_cast<std::uint32_t>(raw_) + static_cast<std::uint32_t>(f.raw_));
+    return *this;
+  }
+
+  constexpr auto operator-=(Fixed f) -> Fixed& {
+    raw_ = wrap(static_cast<std::uint32_t>(raw_) - static_cast<std::uint32_t>(f.raw_));
+    return *this;
+  }
+
+  // ties round up, adding half an ulp before the arithmetic shift
+  constexpr auto operator*=(Fixed f) -> Fixed& {
+    std::int64_t p = static_cast<std::int64_t>(raw_) * f.raw_;
+    raw_ = static_cast<std::int32_t>((p + (std::int64_t(1) << (FractionBits - 1))) >> FractionBits);
+    return *this;
+  }
+
+  constexpr auto operator/=(Fixed f) -> Fixed& {
+    assert(f.raw_ != 0);
+
+    // round half away from zero
+    std::int64_t n = static_cast<std::int64_t>(raw_) * one;
+    std::int64_t half = (n < 0) == (f.raw_ < 0) ? f.raw_ / 2 : -(f.raw_ / 2);
+    raw_ = static_cast<std::int32_t>((n + half) / f.raw_);
+    return *this;
+  }
+
+  friend constexpr auto operator+(Fixed a, Fixed b) -> Fixed { return a += b; }
+  friend constexpr auto operator-(Fixed a, Fixed b) -> Fixed { return a -= b; }
+  friend constexpr auto operator*(Fixed a, Fixed b) -> Fixed { return a *= b; }
+  friend constexpr auto operator/(Fixed a, Fixed b) -> Fixed { return a /= b; }
+
+  friend constexpr auto operator==(Fixed a, Fixed b) -> bool { return a.raw_ == b.raw_; }
+  friend constexpr auto operator!=(Fixed a, Fixed b) -> bool { return a.raw_ != b.raw_; }
+  friend constexpr auto operator<(Fixed a, Fixed b) -> bool { return a.raw_ < b.raw_; }
+  friend constexpr auto operator<=(Fixed a, Fixed b) -> bool { return a.raw_ <= b.raw_; }
+  friend constexpr auto operator>(Fixed a, Fixed b) -> bool { return a.raw_ > b.raw_; }
+  friend constexpr auto operator>=(Fixed a, Fixed b) -> bool { return a.raw_ >= b.raw_; }
+
+  // found by argument-dependent lookup from generic code (using std::sqrt; sqrt(x))
+  friend auto sqrt(Fixed f) -> Fixed { return Fixed(std::sqrt(static_cast<double>(f))); }
+  friend constexpr auto abs(Fixed f) -> Fixed { return f.raw_ < 0 ? -f : f; }
+};
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_FIXED_HPP
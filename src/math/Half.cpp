@@ -0,0 +1,50 @@
+#include "Half.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "Dispatch.hpp"
+#include "Span.hpp"
+
+namespace {
+
+static_assert(sizeof(morpheus::Half) == sizeof(std::uint16_t), "batched kernels expect packed halves");
+static_assert(sizeof(morpheus::Vector2h) == 2 * sizeof(morpheus::Half), "batched kernels expect packed vectors");
+static_assert(sizeof(morpheus::Vector3h) == 3 * sizeof(morpheus::Half), "batched kernels expect packed vectors");
+static_assert(sizeof(morpheus::Vector4h) == 4 * sizeof(morpheus::Half), "batched kernels expect packed vectors");
+
+template <std::size_t N>
+void to_half_n(morpheus::span<const morpheus::Vector<float, N>> in,
+               morpheus::span<morpheus::Vector<morpheus::Half, N>> out) {
+  assert(out.size() >= in.size());
+  morpheus::get_batch_kernels().to_half(reinterpret_cast<const float*>(in.data()),
+                                        reinterpret_cast<std::uint16_t*>(out.data()), N * in.size());
+}
+
+template <std::size_t N>
+void to_float_n(morpheus::span<const morpheus::Vector<morpheus::Half, N>> in,
+                morpheus::span<morpheus::Vector<float, N>> out) {
+  assert(out.size() >= in.size());
+  morpheus::get_batch_kernels().to_float(reinterpret_cast<const std::uint16_t*>(in.data()),
+                                         reinterpret_cast<float*>(out.data()), N * in.size());
+}
+
+}  // namespace
+
+void morpheus::to_half(span<const float> in, span<Half> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().to_half(in.data(), reinterpret_cast<std::uint16_t*>(out.data()), in.size());
+}
+
+void morpheus::to_half(span<const Vector<float, 2>> in, span<Vector2h> out) { to_half_n<2>(in, out); }
+void morpheus::to_half(span<const Vector<float, 3>> in, span<Vector3h> out) { to_half_n<3>(in, out); }
+void morpheus::to_half(span<const Vector<float, 4>> in, span<Vector4h> out) { to_half_n<4>(in, out); }
+
+void morpheus::to_float(span<const Half> in, span<float> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().to_float(reinterpret_cast<const std::uint16_t*>(in.data()), out.data(), in.size());
+}
+
+void morpheus::to_float(span<const Vector2h> in, span<Vector<float, 2>> out) { to_float_n<2>(in, out); }
+void morpheus::to_float(span<const Vector3h> in, span<Vector<float, 3>> out) { to_float_n<3>(in, out); }
+void morpheus::to_float(span<const Vector4h> in, span<Vector<float, 4>> out) { to_float_n<4>(in, out); }
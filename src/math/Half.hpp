@@ -0,0 +1,145 @@
+#ifndef MORPHEUS_HALF_HPP
+#define MORPHEUS_HALF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Vector.hpp"
+
+namespace morpheus {
+
+namespace detail {
+
+// round to nearest even like the f16c instructions. overflow goes to infinity,
+// nans stay nans (quiet, payload truncated)
+inline auto float_to_half_bits(float f) -> std::uint16_t {
+#if defined(MORPHEUS_F16C)
+  return static_cast<std::uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+  std::uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  std::uint32_t sign = (u >> 16) & 0x8000;
+  u &= 0x7fffffff;
+
+  std::uint32_t h;
+  if (u >= 0x47800000) {
+    // at least 65536, infinity or nan
+    h = u > 0x7f800000 ? 0x7e00 | ((u >> 13) & 0x3ff) : 0x7c00;
+  } else if (u < 0x38800000) {
+    // below the smallest normal half, adding 0.5 shifts the mantissa into place
+    // and the float addition rounds it to nearest even
+    float g;
+    std::memcpy(&g, &u, sizeof(g));
+    g += 0.5F;
+    std::memcpy(&h, &g, sizeof(h));
+    h -= 0x3f000000;
+  } else {
+    // rebias the exponent, add half an ulp minus one and the odd bit to round to
+    // nearest even. a carry out of the mantissa correctly bumps the exponent
+    std::uint32_t odd = (u >> 13) & 1;
+    h = (u - ((127 - 15) << 23) + 0xfff + odd) >> 13;
+  }
+  return static_cast<std::uint16_t>(h | sign);
+#endif
+}
+
+// exact, every half is a float
+inline auto half_bits_to_float(std::uint16_t h) -> float {
+#if defined(MORPHEUS_F16C)
+  return _cvtsh_ss(h);
+#else
+  std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+  std::uint32_t u = static_cast<std::uint32_t>(h & 0x7fff) << 13;
+  std::uint32_t exponent = u & 0x0f800000;
+  u += (127 - 15) << 23;
+
+  float f;
+  if (exponent == 0x0f800000) {
+    // infinity or nan, quieted like the f16c instructions do
+    u += (128 - 16) << 23;
+    if ((u & 0x7fffff) != 0) u |= 0x400000;
+    std::memcpy(&f, &u, sizeof(f));
+  } else if (exponent == 0) {
+    // zero or subnormal, renormalized by a float subtraction
+    u += 1 << 23;
+    std::memcpy(&f, &u, sizeof(f));
+    f -= 6.103515625e-05F;
+  } else {
+    std::memcpy(&f, &u, sizeof(f));
+  }
+
+  std::uint32_t r;
+  std::memcpy(&r, &f, sizeof(r));
+  r |= sign;
+  std::memcpy(&f, &r, sizeof(f));
+  return f;
+#endif
+}
+
+}  // namespace detail
+
+// ieee 754 binary16 number: 1 sign, 5 exponent and 10 mantissa bits, about 3
+// decimal digits over [6.1e-5, 65504] plus subnormals down to 6e-8. a storage
+// type for bandwidth bound data like vertex attributes, without arithmetic of
+// its own: convert to float, compute and convert back.
+// usable as the scalar type of Vector (Vector3h is 6 bytes, Vector4h 8)
+class Half {
+ private:
+  std::uint16_t bits_{0};
+
+ public:
+  Half() = default;
+  explicit Half(float f) : bits_(detail::float_to_half_bits(f)) {}
+
+  static constexpr auto from_bits(std::uint16_t bits) -> Half {
+    Half h;
+    h.bits_ = bits;
+    return h;
+  }
+
+  constexpr auto bits() const -> std::uint16_t { return bits_; }
+
+  explicit operator float() const { return detail::half_bits_to_float(bits_); }
+
+  // bitwise, so +0 and -0 differ and a nan equals itself
+  friend constexpr auto operator==(Half a, Half b) -> bool { return a.bits_ == b.bits_; }
+  friend constexpr auto operator!=(Half a, Half b) -> bool { return a.bits_ != b.bits_; }
+};
+
+using Vector2h = Vector<Half, 2>;
+using Vector3h = Vector<Half, 3>;
+using Vector4h = Vector<Half, 4>;
+
+template <std::size_t N>
+inline auto to_half(const Vector<float, N>& v) -> Vector<Half, N> {
+  Vector<Half, N> h;
+  for (std::size_t i = 0; i < N; ++i) h[i] = Half(v[i]);
+  return h;
+}
+
+template <std::size_t N>
+inline auto to_float(const Vector<Half, N>& h) -> Vector<float, N> {
+  Vector<float, N> v;
+  for (std::size_t i = 0; i < N; ++i) v[i] = static_cast<float>(h[i]);
+  return v;
+}
+
+// streams converted with the kernels of the current simd level (see Dispatch.hpp),
+// 8 or 16 elements per f16c instruction where the cpu supports it.
+// out must hold at least as many elements as in
+void to_half(span<const float> in, span<Half> out);
+void to_half(span<const Vector<float, 2>> in, span<Vector2h> out);
+void to_half(span<const Vector<float, 3>> in, span<Vector3h> out);
+void to_half(span<const Vector<float, 4>> in, span<Vector4h> out);
+
+void to_float(span<const Half> in, span<float> out);
+void to_float(span<const Vector2h> in, span<Vector<float, 2>> out);
+void to_float(span<const Vector3h> in, span<Vector<float, 3>> out);
+void to_float(span<const Vector4h> in, span<Vector<float, 4>> out);
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_HALF_HPP
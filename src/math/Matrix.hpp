@@ -0,0 +1,262 @@
+#ifndef MORPHEUS_MATRIX_HPP
+#define MORPHEUS_MATRIX_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+namespace morpheus {
+
+// R x C matrix of T stored in column-major order, every column is a Vector<T, R>
+// (so columns of float 4x4 matrices are 16-byte aligned for the sse kernels).
+// constexpr so that constant matrices and tables of them are built at compile time,
+// the float 4x4 simd overloads below are runtime only
+template <typename T, std::size_t R, std::size_t C>
+class Matrix {
+ protected:
+  Vector<T, R> n_[C]{};
+
+ public:
+  using value_type = T;
+  static const std::size_t rows = R;
+  static const std::size_t cols = C;
+
+  Matrix() = default;
+
+  // elements listed row by row
+  constexpr Matrix(std::initializer_list<std::initializer_list<T>> init_list) {
+    assert(init_list.size() == R);
+
+    int row = 0;
+    int col = 0;
+    for (auto sublist : init_list) {
+      assert(sublist.size() == C);
+      for (T element : sublist) {
+        // changed order from conventional row, col to col, row
+        // to support subscript operator[] -> Vector&
+        n_[col][row] = element;
+        ++col;
+      }
+      col = 0;
+      ++row;
+    }
+  }
+
+  // columns listed in order
+  constexpr Matrix(std::initializer_list<Vector<T, R>> init_list) {
+    assert(init_list.size() == C);
+
+    int col = 0;
+    for (const Vector<T, R>& v : init_list) n_[col++] = v;
+  }
+
+  constexpr auto operator()(int row, int col) -> T& {
+    // changed order from conventional row, col to col, row
+    // to support subscript operator[] -> Vector&
+    return n_[col][row];
+  }
+
+  constexpr auto operator()(int row, int col) const -> const T& { return n_[col][row]; }
+
+  // interface-wise column of a matrix is a vector, storage is column by column
+  constexpr auto operator[](int col) -> Vector<T, R>& { return n_[col]; }
+  constexpr auto operator[](int col) const -> const Vector<T, R>& { return n_[col]; }
+
+  constexpr auto data() -> T* { return n_[0].data(); }
+  constexpr auto data() const -> const T* { return n_[0].data(); }
+
+  constexpr auto operator*=(const Matrix<T, C, C>& m) -> Matrix& {
+    matrix_multiply(*this, m, *this);
+    return *this;
+  }
+
+  constexpr auto determinant() const -> T { return matrix_determinant(*this); }
+
+  constexpr auto inverse() -> Matrix& {
+    matrix_inverse(*this);
+    return *this;
+  }
+};
+
+// kernels behind the matrix operators. the generic versions are unrolled at compile
+// time, simd versions are non-template overloads for a scalar type and size, which
+// overload resolution prefers (see the end of this file)
+
+// out = a * b, out may alias a or b
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr void matrix_multiply(const Matrix<T, R, K>& a, const Matrix<T, K, C>& b, Matrix<T, R, C>& out) {
+  Matrix<T, R, C> tmp;
+  unroll<C>::apply([&](std::size_t col) {
+    unroll<K>::apply([&](std::size_t k) {
+      // changed order from row, col k to col, k, row
+      // to minimize cache misses (because data is stored in col, row order)
+      unroll<R>::apply([&](std::size_t row) { tmp[col][row] += a[k][row] * b[col][k]; });
+    });
+  });
+  out = tmp;
+}
+
+template <typename T>
+constexpr auto matrix_determinant(const Matrix<T, 2, 2>& m) -> T {
+  return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+}
+
+template <typename T>
+constexpr auto matrix_determinant(const Matrix<T, 3, 3>& m) -> T {
+  return (m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+          + m(0, 1) * (m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2))
+          + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0)));
+}
+
+template <typename T>
+constexpr auto matrix_determinant(const Matrix<T, 4, 4>& m) -> T {
+  // expansion by complementary 2x2 minors of the upper two and lower two rows
+  T a0 = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+  T a1 = m(0, 0) * m(1, 2) - m(0, 2) * m(1, 0);
+  T a2 = m(0, 0) * m(1, 3) - m(0, 3) * m(1, 0);
+  T a3 = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+  T a4 = m(0, 1) * m(1, 3) - m(0, 3) * m(1, 1);
+  T a5 = m(0, 2) * m(1, 3) - m(0, 3) * m(1, 2);
+  T b0 = m(2, 0) * m(3, 1) - m(2, 1) * m(3, 0);
+  T b1 = m(2, 0) * m(3, 2) - m(2, 2) * m(3, 0);
+  T b2 = m(2, 0) * m(3, 3) - m(2, 3) * m(3, 0);
+  T b3 = m(2, 1) * m(3, 2) - m(2, 2) * m(3, 1);
+  T b4 = m(2, 1) * m(3, 3) - m(2, 3) * m(3, 1);
+  T b5 = m(2, 2) * m(3, 3) - m(2, 3) * m(3, 2);
+
+  return a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+}
+
+template <typename T>
+constexpr void matrix_inverse(Matrix<T, 2, 2>& m) {
+  T inv_det = T(1) / matrix_determinant(m);
+  m = {{m(1, 1) * inv_det, -m(0, 1) * inv_det},
+       {-m(1, 0) * inv_det, m(0, 0) * inv_det}};
+}
+
+template <typename T>
+constexpr void matrix_inverse(Matrix<T, 3, 3>& m) {
+  // rows of the inverse are the cross products of the columns
+  Vector<T, 3> r0 = cross(m[1], m[2]);
+  Vector<T, 3> r1 = cross(m[2], m[0]);
+  Vector<T, 3> r2 = cross(m[0], m[1]);
+
+  T inv_det = T(1) / dot(r2, m[2]);
+
+  m = {{r0.x() * inv_det, r0.y() * inv_det, r0.z() * inv_det},
+       {r1.x() * inv_det, r1.y() * inv_det, r1.z() * inv_det},
+       {r2.x() * inv_det, r2.y() * inv_det, r2.z() * inv_det}};
+}
+
+// closed-form adjugate from the 2x2 minors of the upper and lower two rows, for
+// any element type T. the batch kernels keep their own copy (adjugate in
+// BatchKernels.cpp), as they must not call inline functions of the library
+// headers. m and r hold elements in column-major order, returns the determinant
+template <typename F>
+constexpr auto cofactor_adjugate(const F* m, F* r) -> F {
+  const F& m00 = m[0];  const F& m01 = m[4];  const F& m02 = m[8];   const F& m03 = m[12];
+  const F& m10 = m[1];  const F& m11 = m[5];  const F& m12 = m[9];   const F& m13 = m[13];
+  const F& m20 = m[2];  const F& m21 = m[6];  const F& m22 = m[10];  const F& m23 = m[14];
+  const F& m30 = m[3];  const F& m31 = m[7];  const F& m32 = m[11];  const F& m33 = m[15];
+
+  F a0 = m00 * m11 - m01 * m10;
+  F a1 = m00 * m12 - m02 * m10;
+  F a2 = m00 * m13 - m03 * m10;
+  F a3 = m01 * m12 - m02 * m11;
+  F a4 = m01 * m13 - m03 * m11;
+  F a5 = m02 * m13 - m03 * m12;
+  F b0 = m20 * m31 - m21 * m30;
+  F b1 = m20 * m32 - m22 * m30;
+  F b2 = m20 * m33 - m23 * m30;
+  F b3 = m21 * m32 - m22 * m31;
+  F b4 = m21 * m33 - m23 * m31;
+  F b5 = m22 * m33 - m23 * m32;
+
+  // r[col * 4 + row]
+  r[0]  =   m11 * b5 - m12 * b4 + m13 * b3;
+  r[4]  = - m01 * b5 + m02 * b4 - m03 * b3;
+  r[8]  =   m31 * a5 - m32 * a4 + m33 * a3;
+  r[12] = - m21 * a5 + m22 * a4 - m23 * a3;
+  r[1]  = - m10 * b5 + m12 * b2 - m13 * b1;
+  r[5]  =   m00 * b5 - m02 * b2 + m03 * b1;
+  r[9]  = - m30 * a5 + m32 * a2 - m33 * a1;
+  r[13] =   m20 * a5 - m22 * a2 + m23 * a1;
+  r[2]  =   m10 * b4 - m11 * b2 + m13 * b0;
+  r[6]  = - m00 * b4 + m01 * b2 - m03 * b0;
+  r[10] =   m30 * a4 - m31 * a2 + m33 * a0;
+  r[14] = - m20 * a4 + m21 * a2 - m23 * a0;
+  r[3]  = - m10 * b3 + m11 * b1 - m12 * b0;
+  r[7]  =   m00 * b3 - m01 * b1 + m02 * b0;
+  r[11] = - m30 * a3 + m31 * a1 - m32 * a0;
+  r[15] =   m20 * a3 - m21 * a1 + m22 * a0;
+
+  return a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+}
+
+template <typename T>
+constexpr void matrix_inverse(Matrix<T, 4, 4>& m) {
+  // copied element by element rather than through data() so that it can be
+  // evaluated at compile time
+  T a[16]{};
+  T r[16]{};
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) a[col * 4 + row] = m(row, col);
+  }
+  T inv_det = T(1) / cofactor_adjugate(a, r);
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) m(row, col) = r[col * 4 + row] * inv_det;
+  }
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr auto operator*(const Matrix<T, R, K>& a, const Matrix<T, K, C>& b) -> Matrix<T, R, C> {
+  Matrix<T, R, C> tmp;
+  matrix_multiply(a, b, tmp);
+  return tmp;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr auto operator*(const Matrix<T, R, C>& m, const Vector<T, C>& v) -> Vector<T, R> {
+  // linear combination of the columns of m weighted by the elements of v
+  Vector<T, R> tmp;
+  unroll<C>::apply([&](std::size_t k) {
+    unroll<R>::apply([&](std::size_t row) { tmp[row] += m[k][row] * v[k]; });
+  });
+  return tmp;
+}
+
+template <typename T, std::size_t N>
+constexpr auto determinant(const Matrix<T, N, N>& m) -> T { return m.determinant(); }
+
+template <typename T, std::size_t N>
+constexpr auto inverse(Matrix<T, N, N> m) -> Matrix<T, N, N> { return m.inverse(); }
+
+// simd overloads for float 4x4 matrices, defined in Matrix4.cpp
+void matrix_multiply(const Matrix<float, 4, 4>& a, const Matrix<float, 4, 4>& b, Matrix<float, 4, 4>& out);
+void matrix_inverse(Matrix<float, 4, 4>& m);
+
+inline auto operator*(const Matrix<float, 4, 4>& m, const Vector<float, 4>& v) -> Vector<float, 4> {
+  // linear combination of the columns of m weighted by the elements of v
+#if defined(MORPHEUS_SSE)
+  __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(m[0].data()), _mm_set1_ps(v.x())),
+                                   _mm_mul_ps(_mm_load_ps(m[1].data()), _mm_set1_ps(v.y()))),
+                        _mm_add_ps(_mm_mul_ps(_mm_load_ps(m[2].data()), _mm_set1_ps(v.z())),
+                                   _mm_mul_ps(_mm_load_ps(m[3].data()), _mm_set1_ps(v.w()))));
+  Vector<float, 4> tmp;
+  _mm_store_ps(tmp.data(), r);
+  return tmp;
+#else
+  Vector<float, 4> tmp;
+  unroll<4>::apply([&](std::size_t k) {
+    unroll<4>::apply([&](std::size_t row) { tmp[row] += m[k][row] * v[k]; });
+  });
+  return tmp;
+#endif
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_MATRIX_HPP
@@ -1,54 +1,88 @@
 #ifndef MORPHEUS_MATRIX3_HPP
 #define MORPHEUS_MATRIX3_HPP
 
-#include <array>
 #include <initializer_list>
 
+#include "Matrix.hpp"
+#include "Span.hpp"
 #include "Vector3.hpp"
 
-using array_float_3_3 = std::array<std::array<float, 3>, 3>;
 using initializer_list_float = std::initializer_list<std::initializer_list<float>>;
 using initializer_list_vector3 = std::initializer_list<morpheus::Vector3>;
 
 namespace morpheus {
 
-class Matrix3 {
- private:
-  array_float_3_3 n_{};
+using Matrix3 = Matrix<float, 3, 3>;
 
- public:
-  Matrix3() = default;
-  Matrix3(initializer_list_float init_list);
-  Matrix3(initializer_list_vector3 init_list);
+// P selects the precision of the trigonometry (see Precision.hpp), instantiated
+// for precision::precise and precision::fast in Matrix3.cpp
+template <typename P = default_precision>
+auto make_rotation_matrix_x(float t) -> Matrix3;
+template <typename P = default_precision>
+auto make_rotation_matrix_y(float t) -> Matrix3;
+template <typename P = default_precision>
+auto make_rotation_matrix_z(float t) -> Matrix3;
+template <typename P = default_precision>
+auto make_rotation_matrix(float t, const Vector3& a) -> Matrix3;
+template <typename P = default_precision>
+auto make_skew_matrix(float t, const Vector3& a, const Vector3& b) -> Matrix3;
 
-  auto operator()(int row, int col) -> float&;
-  auto operator()(int row, int col) const -> const float& { return (*this)(row, col); }
+// out[i] = make_rotation_matrix<precision::fast>(angles[i], axes[i]) with the
+// kernels of the current simd level (see Dispatch.hpp), which evaluate the sines
+// and cosines of 8 angles at once with avx2 and 16 with avx-512. axes must be
+// unit vectors, angles and axes have the same size and out must hold at least as
+// many elements
+void make_rotation_matrices(span<const float> angles, span<const Vector3> axes, span<Matrix3> out);
 
-  auto operator[](int col) -> Vector3&;
-  auto operator[](int col) const -> const Vector3& { return (*this)[col]; }
+// builders without trigonometry are constexpr so that constant basis changes are
+// built at compile time
 
-  auto operator*=(const Matrix3& m) -> Matrix3&;
+constexpr auto make_reflection_matrix(const Vector3& a) -> Matrix3 {
+  float x = a.x() * -2.0F;
+  float y = a.y() * -2.0F;
+  float z = a.z() * -2.0F;
+  float axay = x * a.y();
+  float axaz = x * a.z();
+  float ayaz = y * a.z();
 
-  auto determinant() const -> float;
-  auto inverse() -> Matrix3&;
-};
+  return {{ x * a.x() + 1.0F, axay,             axaz             },
+          { axay,             y * a.y() + 1.0F, ayaz             },
+          { axaz,             ayaz,             z * a.z() + 1.0F }};
+}
 
-auto operator*(Matrix3 a, const Matrix3& b) -> Matrix3;
-auto operator*(Matrix3 m, Vector3 v) -> Vector3;
+constexpr auto make_involution_matrix(const Vector3& a) -> Matrix3 {
+  float x = a.x() * 2.0F;
+  float y = a.y() * 2.0F;
+  float z = a.z() * 2.0F;
+  float axay = x * a.y();
+  float axaz = x * a.z();
+  float ayaz = y * a.z();
 
-inline auto determinant(const Matrix3& m) -> float { return m.determinant(); }
-inline auto inverse(Matrix3 m) -> Matrix3 { return m.inverse(); }
+  return {{ x * a.x() - 1.0F, axay,             axaz             },
+          { axay,             y * a.y() - 1.0F, ayaz             },
+          { axaz,             ayaz,             z * a.z() - 1.0F }};
+}
 
-auto make_rotation_matrix_x(float t) -> Matrix3;
-auto make_rotation_matrix_y(float t) -> Matrix3;
-auto make_rotation_matrix_z(float t) -> Matrix3;
-auto make_rotation_matrix(float t, const Vector3& a) -> Matrix3;
-auto make_reflection_matrix(const Vector3& a) -> Matrix3;
-auto make_involution_matrix(const Vector3& a) -> Matrix3;
-auto make_scale_matrix(float sx, float sy, float sz) -> Matrix3;
-auto make_scale_matrix(float s, const Vector3& a) -> Matrix3;
-auto make_skew_matrix(float t, const Vector3& a, const Vector3& b) -> Matrix3;
+constexpr auto make_scale_matrix(float sx, float sy, float sz) -> Matrix3 {
+  return {{ sx,   0.0F, 0.0F },
+          { 0.0F, sy,   0.0F },
+          { 0.0F, 0.0F, sz   }};
+}
+
+constexpr auto make_scale_matrix(float s, const Vector3& a) -> Matrix3 {
+  s -= 1.0F;
+  float x = a.x() * s;
+  float y = a.y() * s;
+  float z = a.z() * s;
+  float axay = x * a.y();
+  float axaz = x * a.z();
+  float ayaz = y * a.z();
+
+  return {{ x * a.x() + 1.0F, axay,             axaz             },
+          { axay,             y * a.y() + 1.0F, ayaz             },
+          { axaz,             ayaz,             z * a.z() + 1.0F }};
+}
 
 }  // namespace morpheus
 
-#endif  // MORPHEUS_MATRIX3_HPP
\ No newline at end of file
+#endif  // MORPHEUS_MATRIX3_HPP
@@ -1,124 +1,170 @@
 #include "Matrix4.hpp"
 
-#include <initializer_list>
+#include <array>
+#include <cassert>
+#include <cstddef>
 
-#include "Vector3.hpp"
+#include "Dispatch.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
 #include "Vector4.hpp"
 
-morpheus::Matrix4::Matrix4(const initializer_list_float init_list) {
-  assert(init_list.size() == 4);
-  for (auto sublist : init_list) assert(sublist.size() == 4);
-
-  int row = 0;
-  int col = 0;
-  for (auto sublist : init_list) {
-    for (float element : sublist) {
-      // changed order from conventional row, col to col, row
-      // to support subscript operator[] -> Vector4&
-      n_[col][row] = element;
-      ++col;
-    }
-    col = 0;
-    ++row;
+namespace {
+
+static_assert(sizeof(morpheus::Matrix4) == 16 * sizeof(float), "batched kernels expect packed matrices");
+
+}  // namespace
+
+void morpheus::matrix_multiply(const Matrix4& a, const Matrix4& b, Matrix4& out) {
+  // column j of the product is a linear combination of the columns of a
+  // weighted by the elements of column j of b. all columns are computed before
+  // storing anything so that out may alias a or b
+#if defined(MORPHEUS_AVX)
+  // two result columns per 256-bit register
+  __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[0].data()));
+  __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[1].data()));
+  __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[2].data()));
+  __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[3].data()));
+
+  __m256 r[2];
+  for (int i = 0; i < 2; ++i) {
+    __m256 c = _mm256_loadu_ps(b[2 * i].data());
+#if defined(MORPHEUS_FMA)
+    r[i] = _mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00));
+    r[i] = _mm256_fmadd_ps(a1, _mm256_permute_ps(c, 0x55), r[i]);
+    r[i] = _mm256_fmadd_ps(a2, _mm256_permute_ps(c, 0xAA), r[i]);
+    r[i] = _mm256_fmadd_ps(a3, _mm256_permute_ps(c, 0xFF), r[i]);
+#else
+    r[i] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00)),
+                                       _mm256_mul_ps(a1, _mm256_permute_ps(c, 0x55))),
+                         _mm256_add_ps(_mm256_mul_ps(a2, _mm256_permute_ps(c, 0xAA)),
+                                       _mm256_mul_ps(a3, _mm256_permute_ps(c, 0xFF))));
+#endif
   }
-}
-
-morpheus::Matrix4::Matrix4(initializer_list_vector4 init_list) {
-  assert(init_list.size() == 4);
-
-  int row = 0;
-  int col = 0;
-  for (morpheus::Vector4 v : init_list) {
-    for (int row = 0; row < 4; ++row) {
-      // changed order from conventional row, col to col, row
-      // to support subscript operator[] -> Vector4&
-      n_[col][row] = v[row];
-    }
-    ++col;
+  _mm256_storeu_ps(out[0].data(), r[0]);
+  _mm256_storeu_ps(out[2].data(), r[1]);
+#elif defined(MORPHEUS_SSE)
+  __m128 a0 = _mm_load_ps(a[0].data());
+  __m128 a1 = _mm_load_ps(a[1].data());
+  __m128 a2 = _mm_load_ps(a[2].data());
+  __m128 a3 = _mm_load_ps(a[3].data());
+
+  __m128 r[4];
+  for (int col = 0; col < 4; ++col) {
+    const float* c = b[col].data();
+    r[col] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(c[0])),
+                                   _mm_mul_ps(a1, _mm_set1_ps(c[1]))),
+                        _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(c[2])),
+                                   _mm_mul_ps(a3, _mm_set1_ps(c[3]))));
   }
-}
-
-auto morpheus::Matrix4::operator()(int row, int col) -> float& {
-  // changed order from conventional row, col to col, row
-  // to support subscript operator[] -> Vector4&
-  return n_[col][row];
-}
-
-auto morpheus::Matrix4::operator[](int col) -> Vector4& {
-  // interface-wise column of a matrix4 is a vector4
-  // but implementation-wise it must be a row to support subscript operator[] -> Vector4& 
-  // (because of the way array is stored in memory)
-  // so changed order from conventional row, col  to reversed col, row
-  return reinterpret_cast<Vector4&>(n_[col]);
-}
-
-auto morpheus::Matrix4::operator*=(const Matrix4& m) -> Matrix4& {
+  for (int col = 0; col < 4; ++col) _mm_store_ps(out[col].data(), r[col]);
+#else
   Matrix4 tmp;
   for (int col = 0; col < 4; ++col) {
     for (int k = 0; k < 4; ++k) {
       for (int row = 0; row < 4; ++row) {
         // changed order from row, col k to col, k, row
         // to minimize cache misses (because data is stored in col, row order)
-        tmp(row, col) += (*this)(row, k) * m(k, col);
+        tmp[col][row] += a[k][row] * b[col][k];
       }
     }
   }
-  *this = tmp;
-  return *this;
+  out = tmp;
+#endif
 }
 
-// auto morpheus::Matrix4::determinant() const -> float {
-//   return ((*this)(0,0) * ((*this)(1,1) * (*this)(2,2) - (*this)(1,2) * (*this)(2,1))
-// 	      + (*this)(0,1) * ((*this)(1,2) * (*this)(2,0) - (*this)(1,0) * (*this)(2,2))
-// 	      + (*this)(0,2) * ((*this)(1,0) * (*this)(2,1) - (*this)(1,1) * (*this)(2,0)));
-// }
-
-auto morpheus::Matrix4::inverse() -> Matrix4& {
-  const auto& a = reinterpret_cast<const Vector3&>((*this)[0]);
-  const auto& b = reinterpret_cast<const Vector3&>((*this)[1]);
-  const auto& c = reinterpret_cast<const Vector3&>((*this)[2]);
-  const auto& d = reinterpret_cast<const Vector3&>((*this)[3]);
-
-  const float& x = (*this)(3, 0);
-  const float& y = (*this)(3, 1);
-  const float& z = (*this)(3, 2);
-  const float& w = (*this)(3, 3);
-
-  Vector3 s = cross(a, b);
-  Vector3 t = cross(c, d);
-  Vector3 u = a * y - b * x;
-  Vector3 v = c * w - d * z;
-
-  float inv_det = 1.0F / (dot(s, v) + dot(t, u));
-  s *= inv_det;
-  t *= inv_det;
-  u *= inv_det;
-  v *= inv_det;
-
-  Vector3 r0 = cross(b, v) + t * y;
-  Vector3 r1 = cross(v, a) - t * x;
-  Vector3 r2 = cross(d, u) + s * w;
-  Vector3 r3 = cross(u, c) - s * z;
-
-  *this =  {{r0.x(), r0.y(), r0.z(), -dot(b, t)},
-            {r1.x(), r1.y(), r1.z(),  dot(a, t)},
-            {r2.x(), r2.y(), r2.z(), -dot(d, s)},
-            {r3.x(), r3.y(), r3.z(),  dot(c, s)}};
-  
-  return *this;
+void morpheus::matrix_inverse(Matrix4& m) {
+#if defined(MORPHEUS_SSE)
+  // cramer's rule on 2x2 sub-products (intel ap-928), the algorithm is written
+  // for row-major input, fed with column-major data it inverts the transpose
+  // and writes back the transposed result, which is the inverse in column-major order
+  float* src = m.data();
+  __m128 tmp = _mm_setzero_ps();
+  __m128 row0, row1, row2, row3;
+  __m128 minor0, minor1, minor2, minor3;
+
+  tmp = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src)), reinterpret_cast<const __m64*>(src + 4));
+  row1 = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src + 8)), reinterpret_cast<const __m64*>(src + 12));
+  row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+  row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+  tmp = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src + 2)), reinterpret_cast<const __m64*>(src + 6));
+  row3 = _mm_loadh_pi(_mm_loadl_pi(tmp, reinterpret_cast<const __m64*>(src + 10)), reinterpret_cast<const __m64*>(src + 14));
+  row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+  row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+  tmp = _mm_mul_ps(row2, row3);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  minor0 = _mm_mul_ps(row1, tmp);
+  minor1 = _mm_mul_ps(row0, tmp);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+  minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+  minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+  tmp = _mm_mul_ps(row1, row2);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+  minor3 = _mm_mul_ps(row0, tmp);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+  minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+  minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+  tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+  minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+  minor2 = _mm_mul_ps(row0, tmp);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+  minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+  minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+  tmp = _mm_mul_ps(row0, row1);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+  minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+  minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+  tmp = _mm_mul_ps(row0, row3);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+  minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+  minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+  tmp = _mm_mul_ps(row0, row2);
+  tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+  minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+  minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+  tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+  minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+  minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+  __m128 det = _mm_mul_ps(row0, minor0);
+  det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+  det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+  det = _mm_div_ss(_mm_set_ss(1.0F), det);
+  det = _mm_shuffle_ps(det, det, 0x00);
+
+  _mm_store_ps(src, _mm_mul_ps(det, minor0));
+  _mm_store_ps(src + 4, _mm_mul_ps(det, minor1));
+  _mm_store_ps(src + 8, _mm_mul_ps(det, minor2));
+  _mm_store_ps(src + 12, _mm_mul_ps(det, minor3));
+#else
+  std::array<float, 16> r;
+  float inv_det = 1.0F / cofactor_adjugate(m.data(), r.data());
+  for (int i = 0; i < 16; ++i) m.data()[i] = r[i] * inv_det;
+#endif
 }
 
-auto morpheus::operator*(Matrix4 a, const Matrix4& b) -> Matrix4 {
-  a *= b;
-  return a;
-}
+auto morpheus::inverse_batch(span<const Matrix4> in, span<Matrix4> out, span<bool> singular) -> std::size_t {
+  assert(out.size() >= in.size());
+  assert(singular.empty() || singular.size() >= in.size());
 
-auto morpheus::operator*(Matrix4 m, Vector4 v) -> Vector4 {
-  Vector4 tmp;
-  for (int row = 0; row < 4; ++row) {
-    for (int k = 0; k < 4; ++k) {
-        tmp[row] += m(row, k) * v[k];
-    }
-  }
-  return tmp;
+  return get_batch_kernels().inverse(reinterpret_cast<const float*>(in.data()), reinterpret_cast<float*>(out.data()),
+                                     singular.empty() ? nullptr : singular.data(), in.size());
 }
@@ -1,6 +1,9 @@
 #ifndef MORPHEUS_POINT3_HPP
 #define MORPHEUS_POINT3_HPP
 
+#include <type_traits>
+
+#include "Expression.hpp"
 #include "Vector3.hpp"
 
 namespace morpheus {
@@ -8,15 +11,50 @@ namespace morpheus {
 class Point3: public Vector3 {
  public:
   Point3() = default;
-	Point3(float a, float b, float c) : Vector3(a, b, c) {}
+	constexpr Point3(float a, float b, float c) : Vector3(a, b, c) {}
+
+  // evaluates an expression that yields a point, e.g. p + v * t
+  template <typename E,
+            typename = typename std::enable_if<is_expression_of<E, 3, Point3>::value>::type>
+  constexpr Point3(const E& e) : Vector3(e[0], e[1], e[2]) {}
+
+	constexpr auto operator=(const Vector3& v) -> Point3& {
+    Vector3::operator=(v);
+    return *this;
+  }
+
+  template <typename E>
+  constexpr auto operator=(const E& e) -> typename std::enable_if<evaluates_to<E, Vector3>::value, Point3&>::type {
+    Vector3::operator=(e);
+    return *this;
+  }
+};
 
-	auto operator=(const Vector3& v) -> Point3&;
+template <>
+struct expression_traits<Point3> {
+  static const bool value = true;
+  static const std::size_t size = 3;
+  using value_type = float;
+  using result = Point3;
+  using operand = const Point3&;
 };
 
-auto operator+(const Point3& a, const Vector3& b) -> Point3;
-auto operator-(const Point3& a, const Vector3& b) -> Point3;
-auto operator-(const Point3& a, const Point3& b) -> Vector3;
+// point + vector and point - vector are points, point - point is a vector,
+// scaled or negated points are vectors. point + point means nothing and doesn't
+// compile
+template <>
+struct sum_result<Point3, Point3> {};
+
+template <>
+struct difference_result<Point3, Point3> {
+  using type = Vector3;
+};
+
+template <>
+struct scaled_result<Point3> {
+  using type = Vector3;
+};
 
 }  // namespace morpheus
 
-#endif  // MORPHEUS_POINT3_HPP
\ No newline at end of file
+#endif  // MORPHEUS_POINT3_HPP
@@ -0,0 +1,11 @@
+#include "Precision.hpp"
+
+#include <cassert>
+
+#include "Dispatch.hpp"
+#include "Span.hpp"
+
+void morpheus::sincos_batch(span<const float> t, span<float> s, span<float> c) {
+  assert(s.size() >= t.size() && c.size() >= t.size());
+  get_batch_kernels().sincos(t.data(), s.data(), c.data(), t.size());
+}
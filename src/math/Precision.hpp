@@ -0,0 +1,183 @@
+#ifndef MORPHEUS_PRECISION_HPP
+#define MORPHEUS_PRECISION_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Simd.hpp"
+#include "Span.hpp"
+
+namespace morpheus {
+
+// compile-time precision policies of normalize, the rotation builders and the
+// functions below, passed as a template argument (e.g. normalize<precision::fast>(v)).
+// the default is precise, or fast when built with MORPHEUS_FAST_MATH.
+//
+// precise uses std::sqrt, std::sin, std::cos and std::tan (within 1 ulp).
+// fast trades accuracy for speed, worst errors measured against double:
+// - rsqrt: 2.5e-7 relative (sse estimate + one newton step). without simd there's
+//   no estimate to refine and fast is the same as precise
+// - normalize: 3e-7 in the length of the result
+// - sin, cos, sincos: 8e-8 absolute for |t| <= 8192, one cody-waite reduction to
+//   [-pi/4, pi/4] and minimax polynomials of degree 7 (sin) and 8 (cos). the
+//   reduction loses accuracy for larger arguments (1e-6 absolute at |t| = 1e5)
+// - tan: 2e-7 relative for |t| < pi / 2 (polynomial of degree 13, reciprocal in odd
+//   quadrants). errors of the reduction are amplified near the poles, 5e-7 for
+//   |t| <= 1000 and 2e-5 for |t| <= 8192 where |cos t| > 0.01
+// well below what shows up in shading or animation, but results differ from the
+// precise policy in the last bits
+namespace precision {
+
+struct precise {};
+struct fast {};
+
+}  // namespace precision
+
+#if defined(MORPHEUS_FAST_MATH)
+using default_precision = precision::fast;
+#else
+using default_precision = precision::precise;
+#endif
+
+// 1 / sqrt(x) for x > 0
+template <typename T>
+inline auto rsqrt(T x, precision::precise) -> T {
+  using std::sqrt;
+  return T(1) / sqrt(x);
+}
+
+// no fast version for scalar types other than float
+template <typename T>
+inline auto rsqrt(T x, precision::fast) -> T {
+  return rsqrt(x, precision::precise());
+}
+
+inline auto rsqrt(float x, precision::fast) -> float {
+#if defined(MORPHEUS_SSE)
+  // 12-bit estimate, a newton step doubles the number of correct bits
+  float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+  return y * (1.5F - 0.5F * x * y * y);
+#else
+  // without an estimate instruction, refining a bit-level guess to the same
+  // precision takes three steps and is no faster than a square root
+  return rsqrt(x, precision::precise());
+#endif
+}
+
+template <typename P = default_precision, typename T>
+inline auto rsqrt(T x) -> T {
+  return rsqrt(x, P());
+}
+
+namespace detail {
+
+// t = k * pi / 2 + r with |r| <= pi / 4, pi / 2 split into three parts so that
+// k * part is exact for |k| < 2^12 (cody-waite). adding 1.5 * 2^23 rounds to the
+// nearest integer, which ends up in the low bits of the mantissa
+inline auto reduce_quadrant(float t, float& r) -> int {
+  float y = t * 0.636619772F + 12582912.0F;
+  float fk = y - 12582912.0F;
+  r = ((t - fk * 1.5703125F) - fk * 4.837512969970703125e-4F) - fk * 7.54978995489188216e-8F;
+
+  std::uint32_t bits;
+  std::memcpy(&bits, &y, sizeof(bits));
+  return static_cast<int>(bits & 0x7fffff) - 0x400000;
+}
+
+// minimax polynomials on [-pi/4, pi/4] (cephes)
+inline auto sin_polynomial(float r) -> float {
+  float z = r * r;
+  return ((-1.9515295891e-4F * z + 8.3321608736e-3F) * z - 1.6666654611e-1F) * z * r + r;
+}
+
+inline auto cos_polynomial(float r) -> float {
+  float z = r * r;
+  return ((2.443315711809948e-5F * z - 1.388731625493765e-3F) * z + 4.166664568298827e-2F) * z * z - 0.5F * z + 1.0F;
+}
+
+inline auto tan_polynomial(float r) -> float {
+  float z = r * r;
+  float p = ((((9.38540185543e-3F * z + 3.11992232697e-3F) * z + 2.44301354525e-2F) * z + 5.34112807005e-2F) * z
+             + 1.33387994085e-1F) * z + 3.33331568548e-1F;
+  return p * z * r + r;
+}
+
+}  // namespace detail
+
+inline void sincos(float t, float& s, float& c, precision::precise) {
+  // gcc and clang combine the two calls into one sincosf where available
+  s = std::sin(t);
+  c = std::cos(t);
+}
+
+// both from one range reduction, the quadrant swaps and negates the results.
+// done on the bits, gcc turns selects into branches that mispredict whenever
+// consecutive angles fall into different quadrants
+inline void sincos(float t, float& s, float& c, precision::fast) {
+  float r;
+  int k = detail::reduce_quadrant(t, r);
+  float sr = detail::sin_polynomial(r);
+  float cr = detail::cos_polynomial(r);
+
+  std::uint32_t sb, cb;
+  std::memcpy(&sb, &sr, sizeof(sb));
+  std::memcpy(&cb, &cr, sizeof(cb));
+  std::uint32_t swap = (sb ^ cb) & (0U - static_cast<std::uint32_t>(k & 1));
+  sb ^= swap ^ (static_cast<std::uint32_t>(k & 2) << 30);
+  cb ^= swap ^ (static_cast<std::uint32_t>((k + 1) & 2) << 30);
+  std::memcpy(&s, &sb, sizeof(sb));
+  std::memcpy(&c, &cb, sizeof(cb));
+}
+
+template <typename P = default_precision>
+inline void sincos(float t, float& s, float& c) {
+  sincos(t, s, c, P());
+}
+
+// s[i], c[i] = sincos<precision::fast>(t[i]) with the kernels of the current simd
+// level (see Dispatch.hpp), 8 angles at once with avx2 and 16 with avx-512.
+// s and c must hold at least as many elements as t
+void sincos_batch(span<const float> t, span<float> s, span<float> c);
+
+namespace detail {
+
+// sin, cos and tan only take floats, so that unqualified calls with doubles from
+// within the namespace fail to compile instead of silently losing precision
+template <typename T>
+using if_float = typename std::enable_if<std::is_same<T, float>::value, float>::type;
+
+}  // namespace detail
+
+template <typename P = default_precision, typename T>
+inline auto sin(T t) -> detail::if_float<T> {
+  float s, c;
+  sincos<P>(t, s, c);
+  return s;
+}
+
+template <typename P = default_precision, typename T>
+inline auto cos(T t) -> detail::if_float<T> {
+  float s, c;
+  sincos<P>(t, s, c);
+  return c;
+}
+
+inline auto tan(float t, precision::precise) -> float { return std::tan(t); }
+
+inline auto tan(float t, precision::fast) -> float {
+  float r;
+  int k = detail::reduce_quadrant(t, r);
+  float y = detail::tan_polynomial(r);
+  return (k & 1) != 0 ? -1.0F / y : y;
+}
+
+template <typename P = default_precision, typename T>
+inline auto tan(T t) -> detail::if_float<T> {
+  return tan(t, P());
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_PRECISION_HPP
@@ -0,0 +1,19 @@
+#include "Projection.hpp"
+
+#include <cassert>
+#include <cmath>
+
+auto morpheus::make_perspective(float fovy, float aspect, float near_z, float far_z) -> PerspectiveProjection {
+  assert(fovy > 0.0F && aspect > 0.0F && near_z > 0.0F && far_z > near_z);
+
+  float sy = 1.0F / std::tan(fovy * 0.5F);
+  float a = far_z / (near_z - far_z);
+  return {sy / aspect, sy, a, near_z * a};
+}
+
+auto morpheus::make_reverse_z_infinite_perspective(float fovy, float aspect, float near_z) -> PerspectiveProjection {
+  assert(fovy > 0.0F && aspect > 0.0F && near_z > 0.0F);
+
+  float sy = 1.0F / std::tan(fovy * 0.5F);
+  return {sy / aspect, sy, 0.0F, near_z};
+}
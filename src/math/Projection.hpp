@@ -0,0 +1,145 @@
+#ifndef MORPHEUS_PROJECTION_HPP
+#define MORPHEUS_PROJECTION_HPP
+
+#include <cassert>
+
+#include "Matrix4.hpp"
+#include "Point3.hpp"
+#include "Vector4.hpp"
+
+namespace morpheus {
+
+// projections from a right-handed view space looking down -z to clip space with
+// x and y in [-w, w] and depth in [0, w] (see to_window in VectorFixed.hpp).
+// only the non-zero elements are stored and multiplied, a point costs at most 6
+// multiplies instead of the 16 of a Matrix4
+
+// which end of [0, 1] window depth is near: standard projections put the near plane
+// at 0 and need a less depth test, reversed ones (make_reverse_z_infinite_perspective)
+// put it at 1 and need a greater one (see Framebuffer in raster/Framebuffer.hpp)
+enum class DepthRange { standard, reversed };
+
+// sx 0  0  0
+// 0  sy 0  0
+// 0  0  a  b
+// 0  0  -1 0
+class PerspectiveProjection {
+ private:
+  // diagonal and the w row, (sx, sy, a, -1) as one sse register
+  Vector4 scale_{1.0F, 1.0F, 0.0F, -1.0F};
+  float b_{0.0F};
+
+ public:
+  PerspectiveProjection() = default;
+  constexpr PerspectiveProjection(float sx, float sy, float a, float b) : scale_(sx, sy, a, -1.0F), b_(b) {}
+
+  constexpr auto sx() const -> float { return scale_.x(); }
+  constexpr auto sy() const -> float { return scale_.y(); }
+  constexpr auto a() const -> float { return scale_.z(); }
+  constexpr auto b() const -> float { return b_; }
+
+  constexpr auto get_scale() const -> const Vector4& { return scale_; }
+
+  constexpr auto get_matrix() const -> Matrix4 {
+    Matrix4 m;
+    m(0, 0) = sx();
+    m(1, 1) = sy();
+    m(2, 2) = a();
+    m(2, 3) = b_;
+    m(3, 2) = -1.0F;
+    return m;
+  }
+};
+
+// sx 0  0  tx
+// 0  sy 0  ty
+// 0  0  a  b
+// 0  0  0  1
+class OrthographicProjection {
+ private:
+  // diagonal (sx, sy, a, 0) and last column (tx, ty, b, 1) as sse registers
+  Vector4 scale_{1.0F, 1.0F, 1.0F, 0.0F};
+  Vector4 translation_{0.0F, 0.0F, 0.0F, 1.0F};
+
+ public:
+  OrthographicProjection() = default;
+  constexpr OrthographicProjection(float sx, float sy, float a, float tx, float ty, float b)
+      : scale_(sx, sy, a, 0.0F), translation_(tx, ty, b, 1.0F) {}
+
+  constexpr auto sx() const -> float { return scale_.x(); }
+  constexpr auto sy() const -> float { return scale_.y(); }
+  constexpr auto a() const -> float { return scale_.z(); }
+  constexpr auto tx() const -> float { return translation_.x(); }
+  constexpr auto ty() const -> float { return translation_.y(); }
+  constexpr auto b() const -> float { return translation_.z(); }
+
+  constexpr auto get_scale() const -> const Vector4& { return scale_; }
+  constexpr auto get_translation() const -> const Vector4& { return translation_; }
+
+  constexpr auto get_matrix() const -> Matrix4 {
+    Matrix4 m;
+    m(0, 0) = sx();
+    m(1, 1) = sy();
+    m(2, 2) = a();
+    m[3] = translation_;
+    return m;
+  }
+};
+
+inline auto operator*(const PerspectiveProjection& p, const Vector4& v) -> Vector4 {
+#if defined(MORPHEUS_SSE)
+  // (x, y, z, z) * (sx, sy, a, -1) + (0, 0, b, 0) * w
+  __m128 r = _mm_load_ps(v.data());
+  __m128 w = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+  r = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 1, 0)), _mm_load_ps(p.get_scale().data()));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_setr_ps(0.0F, 0.0F, p.b(), 0.0F), w));
+  Vector4 tmp;
+  _mm_store_ps(tmp.data(), r);
+  return tmp;
+#else
+  return {p.sx() * v.x(), p.sy() * v.y(), p.a() * v.z() + p.b() * v.w(), -v.z()};
+#endif
+}
+
+constexpr auto operator*(const PerspectiveProjection& p, const Point3& v) -> Vector4 {
+  return {p.sx() * v.x(), p.sy() * v.y(), p.a() * v.z() + p.b(), -v.z()};
+}
+
+inline auto operator*(const OrthographicProjection& p, const Vector4& v) -> Vector4 {
+#if defined(MORPHEUS_SSE)
+  __m128 r = _mm_load_ps(v.data());
+  __m128 w = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+  r = _mm_add_ps(_mm_mul_ps(r, _mm_load_ps(p.get_scale().data())), _mm_mul_ps(_mm_load_ps(p.get_translation().data()), w));
+  Vector4 tmp;
+  _mm_store_ps(tmp.data(), r);
+  return tmp;
+#else
+  return {p.sx() * v.x() + p.tx() * v.w(), p.sy() * v.y() + p.ty() * v.w(), p.a() * v.z() + p.b() * v.w(), v.w()};
+#endif
+}
+
+constexpr auto operator*(const OrthographicProjection& p, const Point3& v) -> Vector4 {
+  return {p.sx() * v.x() + p.tx(), p.sy() * v.y() + p.ty(), p.a() * v.z() + p.b(), 1.0F};
+}
+
+// vertical field of view fovy in radians, aspect is width / height. depth is 0 at
+// near_z and 1 at far_z
+auto make_perspective(float fovy, float aspect, float near_z, float far_z) -> PerspectiveProjection;
+
+// depth is 1 at near_z and goes to 0 at infinity, so that float depth buffers keep
+// their precision in the distance (a = 0, three multiplies per point). draw with
+// DepthRange::reversed
+auto make_reverse_z_infinite_perspective(float fovy, float aspect, float near_z) -> PerspectiveProjection;
+
+// maps the box [left, right] x [bottom, top] x [-near_z, -far_z] to clip space
+constexpr auto make_orthographic(float left, float right, float bottom, float top, float near_z, float far_z)
+    -> OrthographicProjection {
+  assert(left != right && bottom != top && near_z != far_z);
+
+  return {2.0F / (right - left), 2.0F / (top - bottom), 1.0F / (near_z - far_z),
+          -(right + left) / (right - left), -(top + bottom) / (top - bottom), near_z / (near_z - far_z)};
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_PROJECTION_HPP
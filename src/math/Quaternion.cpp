@@ -0,0 +1,36 @@
+#include "Quaternion.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "Dispatch.hpp"
+#include "Matrix3.hpp"
+#include "Span.hpp"
+
+namespace {
+
+static_assert(sizeof(morpheus::Quaternion) == 4 * sizeof(float), "batched kernels expect packed quaternions");
+static_assert(sizeof(morpheus::Matrix3) == 9 * sizeof(float), "batched kernels expect packed matrices");
+
+}  // namespace
+
+auto morpheus::slerp(const Quaternion& a, const Quaternion& b, float t) -> Quaternion {
+  float d = dot(a, b);
+  float sign = d < 0.0F ? -1.0F : 1.0F;
+  d *= sign;
+
+  if (d > 0.9995F) return nlerp(a, b, t);
+
+  float theta = std::acos(d);
+  float inv_sin = 1.0F / std::sin(theta);
+  float s = std::sin((1.0F - t) * theta) * inv_sin;
+  float u = std::sin(t * theta) * inv_sin * sign;
+  return a * s + b * u;
+}
+
+void morpheus::get_rotation_matrices(span<const Quaternion> in, span<Matrix3> out) {
+  assert(out.size() >= in.size());
+
+  get_batch_kernels().rotation_matrices(reinterpret_cast<const float*>(in.data()),
+                                        reinterpret_cast<float*>(out.data()), in.size());
+}
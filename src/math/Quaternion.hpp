@@ -0,0 +1,156 @@
+#ifndef MORPHEUS_QUATERNION_HPP
+#define MORPHEUS_QUATERNION_HPP
+
+#include <cmath>
+
+#include "Matrix3.hpp"
+#include "Point3.hpp"
+#include "RigidTransform.hpp"
+#include "Span.hpp"
+#include "Transform4.hpp"
+#include "Vector3.hpp"
+
+namespace morpheus {
+
+// q = xi + yj + zk + w, rotations are represented by unit quaternions.
+// composing two rotations costs 16 multiplies instead of 27 for a matrix3 product,
+// and interpolation doesn't need trigonometry (see nlerp)
+class alignas(16) Quaternion {
+ private:
+  float x_{0}, y_{0}, z_{0}, w_{1};
+
+ public:
+  // identity rotation
+  Quaternion() = default;
+  constexpr Quaternion(float x, float y, float z, float w) : x_(x), y_(y), z_(z), w_(w) {}
+  constexpr Quaternion(const Vector3& v, float s) : x_(v.x()), y_(v.y()), z_(v.z()), w_(s) {}
+
+  constexpr auto x() const -> float { return x_; }
+  constexpr auto y() const -> float { return y_; }
+  constexpr auto z() const -> float { return z_; }
+  constexpr auto w() const -> float { return w_; }
+
+  constexpr auto get_vector_part() const -> Vector3 { return {x_, y_, z_}; }
+  constexpr auto get_scalar_part() const -> float { return w_; }
+
+  constexpr auto operator*=(const Quaternion& q) -> Quaternion&;
+  constexpr auto operator*=(float s) -> Quaternion&;
+  constexpr auto operator+=(const Quaternion& q) -> Quaternion&;
+
+  constexpr auto dot(const Quaternion& q) const -> float { return x_ * q.x_ + y_ * q.y_ + z_ * q.z_ + w_ * q.w_; }
+
+  auto magnitude() const -> float { return std::sqrt(dot(*this)); }
+  template <typename P = default_precision>
+  auto normalize() -> Quaternion&;
+
+  // rotation matrix of a unit quaternion
+  constexpr auto get_rotation_matrix() const -> Matrix3;
+};
+
+// hamilton product, a * b rotates by b first and then by a
+constexpr auto Quaternion::operator*=(const Quaternion& q) -> Quaternion& {
+  float x = w_ * q.x_ + x_ * q.w_ + y_ * q.z_ - z_ * q.y_;
+  float y = w_ * q.y_ - x_ * q.z_ + y_ * q.w_ + z_ * q.x_;
+  float z = w_ * q.z_ + x_ * q.y_ - y_ * q.x_ + z_ * q.w_;
+  float w = w_ * q.w_ - x_ * q.x_ - y_ * q.y_ - z_ * q.z_;
+  x_ = x;
+  y_ = y;
+  z_ = z;
+  w_ = w;
+  return *this;
+}
+
+constexpr auto Quaternion::operator*=(float s) -> Quaternion& {
+  x_ *= s;
+  y_ *= s;
+  z_ *= s;
+  w_ *= s;
+  return *this;
+}
+
+constexpr auto Quaternion::operator+=(const Quaternion& q) -> Quaternion& {
+  x_ += q.x_;
+  y_ += q.y_;
+  z_ += q.z_;
+  w_ += q.w_;
+  return *this;
+}
+
+template <typename P>
+inline auto Quaternion::normalize() -> Quaternion& {
+  *this *= rsqrt<P>(dot(*this));
+  return *this;
+}
+
+constexpr auto Quaternion::get_rotation_matrix() const -> Matrix3 {
+  float x2 = x_ * x_;
+  float y2 = y_ * y_;
+  float z2 = z_ * z_;
+  float xy = x_ * y_;
+  float xz = x_ * z_;
+  float yz = y_ * z_;
+  float wx = w_ * x_;
+  float wy = w_ * y_;
+  float wz = w_ * z_;
+
+  return {{ 1.0F - 2.0F * (y2 + z2), 2.0F * (xy - wz),        2.0F * (xz + wy)        },
+          { 2.0F * (xy + wz),        1.0F - 2.0F * (x2 + z2), 2.0F * (yz - wx)        },
+          { 2.0F * (xz - wy),        2.0F * (yz + wx),        1.0F - 2.0F * (x2 + y2) }};
+}
+
+constexpr auto operator*(Quaternion a, const Quaternion& b) -> Quaternion { return a *= b; }
+constexpr auto operator*(Quaternion q, float s) -> Quaternion { return q *= s; }
+constexpr auto operator+(Quaternion a, const Quaternion& b) -> Quaternion { return a += b; }
+
+constexpr auto dot(const Quaternion& a, const Quaternion& b) -> float { return a.dot(b); }
+
+constexpr auto conjugate(const Quaternion& q) -> Quaternion { return {-q.x(), -q.y(), -q.z(), q.w()}; }
+
+template <typename P = default_precision>
+inline auto normalize(Quaternion q) -> Quaternion { return q.normalize<P>(); }
+
+// rotates v by the unit quaternion q (q v q*), expanded to two cross products
+constexpr auto rotate(const Quaternion& q, const Vector3& v) -> Vector3 {
+  Vector3 b = q.get_vector_part();
+  Vector3 t = cross(b, v) * 2.0F;
+  return v + t * q.w() + cross(b, t);
+}
+
+// rotation by angle t around the unit axis a
+template <typename P = default_precision>
+inline auto make_rotation_quaternion(float t, const Vector3& a) -> Quaternion {
+  float s, c;
+  sincos<P>(t * 0.5F, s, c);
+  return {a * s, c};
+}
+
+// rotation followed by a translation
+constexpr auto make_transform(const Quaternion& q, const Point3& p) -> Transform4 {
+  Matrix3 m = q.get_rotation_matrix();
+  return {m[0], m[1], m[2], p};
+}
+
+constexpr auto make_rigid_transform(const Quaternion& q, const Point3& p) -> RigidTransform {
+  return {q.get_rotation_matrix(), p};
+}
+
+// normalized linear interpolation along the shorter arc. doesn't move at constant
+// angular velocity like slerp, but needs no trigonometry and is commutative
+template <typename P = default_precision>
+inline auto nlerp(const Quaternion& a, const Quaternion& b, float t) -> Quaternion {
+  float s = dot(a, b) < 0.0F ? -t : t;
+  return normalize<P>(a * (1.0F - t) + b * s);
+}
+
+// spherical linear interpolation along the shorter arc at constant angular velocity,
+// falls back to nlerp when the quaternions are too close for acos/sin to be accurate
+auto slerp(const Quaternion& a, const Quaternion& b, float t) -> Quaternion;
+
+// rotation matrices of in[i] written to out[i] with the kernels of the current
+// simd level (see Dispatch.hpp)
+// out must hold at least as many elements as in
+void get_rotation_matrices(span<const Quaternion> in, span<Matrix3> out);
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_QUATERNION_HPP
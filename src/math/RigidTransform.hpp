@@ -0,0 +1,99 @@
+#ifndef MORPHEUS_RIGID_TRANSFORM_HPP
+#define MORPHEUS_RIGID_TRANSFORM_HPP
+
+#include <cassert>
+
+#include "Matrix3.hpp"
+#include "Point3.hpp"
+#include "Simd.hpp"
+#include "Transform4.hpp"
+#include "Vector3.hpp"
+
+namespace morpheus {
+
+// rotation followed by a translation (cameras, skeleton bones, most scene nodes).
+// the inverse is the transposed rotation and the rotated, negated translation,
+// without the cross products and determinant of inverse(Transform4), and products
+// of rigid transforms stay rigid.
+// stored as a Transform4 and converts to one wherever a general transform is
+// expected, so that combining it with a scale or a general transform promotes
+// the result to a Transform4
+class RigidTransform {
+ private:
+  Transform4 h_;
+
+  // h must be rigid, not checked
+  explicit constexpr RigidTransform(const Transform4& h) : h_(h) {}
+
+  friend auto operator*(const RigidTransform& a, const RigidTransform& b) -> RigidTransform;
+  friend auto inverse(const RigidTransform& h) -> RigidTransform;
+
+ public:
+  constexpr RigidTransform()
+      : h_(Vector3(1.0F, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F), Vector3(0.0F, 0.0F, 1.0F), Point3(0.0F, 0.0F, 0.0F)) {}
+
+  // r must be a rotation (orthonormal with determinant 1)
+  constexpr RigidTransform(const Matrix3& r, const Point3& p) : h_(r[0], r[1], r[2], p) {
+    float d = determinant(r) - 1.0F;
+    assert(d < 1e-3F && d > -1e-3F);
+    (void)d;
+  }
+
+  constexpr auto get_transform() const -> const Transform4& { return h_; }
+  constexpr operator const Transform4&() const { return h_; }
+
+  constexpr auto operator()(int row, int col) const -> float { return h_(row, col); }
+
+  auto get_rotation() const -> Matrix3 { return {h_[0], h_[1], h_[2]}; }
+  auto get_translation() const -> const Point3& { return h_.get_translation(); }
+  void set_translation(const Point3& p) { h_.set_translation(p); }
+};
+
+inline auto operator*(const RigidTransform& a, const RigidTransform& b) -> RigidTransform {
+  RigidTransform r;
+  compose(a.h_, b.h_, r.h_);
+  return r;
+}
+
+inline auto operator*(const RigidTransform& h, const Vector3& v) -> Vector3 { return h.get_transform() * v; }
+inline auto operator*(const RigidTransform& h, const Point3& p) -> Point3 { return h.get_transform() * p; }
+
+inline auto inverse(const RigidTransform& h) -> RigidTransform {
+  // rows of the rotation become its columns, the translation t becomes -r^t t
+  RigidTransform r;
+#if defined(MORPHEUS_SSE)
+  const float* m = h.h_.data();
+  __m128 c0 = _mm_load_ps(m);
+  __m128 c1 = _mm_load_ps(m + 4);
+  __m128 c2 = _mm_load_ps(m + 8);
+  __m128 c3 = _mm_setzero_ps();
+  __m128 t = _mm_load_ps(m + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+  __m128 u = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+                                   _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+                        _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+  float* n = r.h_.data();
+  _mm_store_ps(n, c0);
+  _mm_store_ps(n + 4, c1);
+  _mm_store_ps(n + 8, c2);
+  _mm_store_ps(n + 12, _mm_sub_ps(_mm_setr_ps(0.0F, 0.0F, 0.0F, 1.0F), u));
+#else
+  const Transform4& m = h.h_;
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 3; ++col) r.h_(row, col) = m(col, row);
+    r.h_(row, 3) = -(m(0, row) * m(0, 3) + m(1, row) * m(1, 3) + m(2, row) * m(2, 3));
+  }
+#endif
+  return r;
+}
+
+// h * a scale along the local axes, no longer rigid
+inline auto scale(const RigidTransform& h, float sx, float sy, float sz) -> Transform4 {
+  const Transform4& m = h.get_transform();
+  return {m[0] * sx, m[1] * sy, m[2] * sz, m.get_translation()};
+}
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_RIGID_TRANSFORM_HPP
@@ -0,0 +1,59 @@
+#ifndef MORPHEUS_SIMD_HPP
+#define MORPHEUS_SIMD_HPP
+
+// selects simd code paths at compile time based on the target instruction set
+// (sse is part of x86-64 baseline, avx/fma require -mavx/-mfma or MORPHEUS_NATIVE_ARCH)
+// every simd path has a scalar fallback, MORPHEUS_NO_SIMD forces the fallback.
+// batch kernels are also dispatched at runtime, see Dispatch.hpp
+
+#if !defined(MORPHEUS_NO_SIMD)
+
+#if defined(__SSE__)
+#define MORPHEUS_SSE 1
+#include <xmmintrin.h>
+#endif
+
+#if defined(__SSE4_1__)
+#define MORPHEUS_SSE4_1 1
+#include <smmintrin.h>
+#endif
+
+#if defined(__SSE4_2__)
+#define MORPHEUS_SSE4_2 1
+#include <nmmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define MORPHEUS_AVX 1
+// gcc 12 warns about the self-initialized placeholders of the avx-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#if defined(__AVX2__)
+#define MORPHEUS_AVX2 1
+#endif
+
+#if defined(__FMA__)
+#define MORPHEUS_FMA 1
+#endif
+
+// half <-> float conversions (see Half.hpp)
+#if defined(__F16C__)
+#define MORPHEUS_F16C 1
+#endif
+
+#if defined(__AVX512F__)
+#define MORPHEUS_AVX512 1
+#endif
+
+#endif  // !defined(MORPHEUS_NO_SIMD)
+
+#endif  // MORPHEUS_SIMD_HPP
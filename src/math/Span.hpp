@@ -0,0 +1,53 @@
+#ifndef MORPHEUS_SPAN_HPP
+#define MORPHEUS_SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace morpheus {
+
+// non-owning view on a contiguous sequence of elements (subset of c++20 std::span)
+template <typename T>
+class span {
+ private:
+  T* data_{nullptr};
+  std::size_t size_{0};
+
+ public:
+  span() = default;
+  span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+  template <std::size_t N>
+  span(T (&array)[N]) : data_(array), size_(N) {}
+
+  // any container exposing contiguous data() and size(), e.g. std::vector or std::array.
+  // elements must have type T up to const (like std::span), a derived type of another
+  // size would be viewed with the wrong stride (e.g. Vector3A as Vector3)
+  template <typename Container,
+            typename E = typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type,
+            typename = typename std::enable_if<std::is_convertible<E (*)[], T (*)[]>::value>::type>
+  span(Container& container) : data_(container.data()), size_(container.size()) {}
+
+  auto data() const -> T* { return data_; }
+  auto size() const -> std::size_t { return size_; }
+  auto empty() const -> bool { return size_ == 0; }
+
+  auto operator[](std::size_t i) const -> T& {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  auto begin() const -> T* { return data_; }
+  auto end() const -> T* { return data_ + size_; }
+
+  auto subspan(std::size_t offset, std::size_t count) const -> span {
+    assert(offset + count <= size_);
+    return {data_ + offset, count};
+  }
+};
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_SPAN_HPP
@@ -1,53 +1,39 @@
 #include "Transform4.hpp"
 
-#include "Vector3.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "BatchKernels.hpp"
+#include "Dispatch.hpp"
+#include "Matrix3.hpp"
+#include "Simd.hpp"
 #include "Point3.hpp"
+#include "Span.hpp"
+#include "Vector3.hpp"
+#include "Vector3A.hpp"
 
-morpheus::Transform4::Transform4(initializer_list_float init_list) {
-  assert(init_list.size() == 3);
-  for (auto sublist : init_list) assert(sublist.size() == 4);
-
-  int row = 0;
-  int col = 0;
-  for (auto sublist : init_list) {
-    for (float element : sublist) {
-      // changed order from conventional row, col to col, row
-      // to support subscript operator[] -> Vector3&
-      n_[col][row] = element;
-      ++col;
-    }
-    col = 0;
-    ++row;
-  }
-  n_[0][3] = n_[1][3] = n_[2][3] = 0.0F; n_[3][3] = 1.0F;
-}
-
-morpheus::Transform4::Transform4(const Vector3& a, const Vector3& b, const Vector3& c, const Point3& p) {
-  n_[0][0] = a.x(); n_[0][1] = a.y(); n_[0][2] = a.z();
-  n_[1][0] = b.x(); n_[1][1] = b.y(); n_[1][2] = b.z();
-  n_[2][0] = c.x(); n_[2][1] = c.y(); n_[2][2] = c.z();
-  n_[3][0] = p.x(); n_[3][1] = p.y(); n_[3][2] = p.z();
+namespace {
 
-  n_[0][3] = n_[1][3] = n_[2][3] = 0.0F; n_[3][3] = 1.0F;
-}
+static_assert(sizeof(morpheus::Point3) == 3 * sizeof(float), "batched kernels expect packed points");
+static_assert(sizeof(morpheus::Vector3) == 3 * sizeof(float), "batched kernels expect packed vectors");
+static_assert(sizeof(morpheus::Vector3A) == 4 * sizeof(float) && alignof(morpheus::Vector3A) == 16,
+              "batched kernels expect padded vectors");
+static_assert(sizeof(morpheus::Transform4) == 16 * sizeof(float), "batched kernels expect packed transforms");
+static_assert(sizeof(morpheus::Matrix3) == 9 * sizeof(float), "batched kernels expect packed matrices");
 
-auto morpheus::Transform4::operator[](int j) -> Vector3& {
-  return *reinterpret_cast<Vector3*>(n_[j].data());
-}
-
-auto morpheus::Transform4::operator[](int j) const -> const Vector3& {
-  return *reinterpret_cast<const Vector3*>(n_[j].data());
-}
+// 3x4 affine part of a transform in row-major order, as the batch kernels take it
+struct Affine {
+  float m[12];
 
-auto morpheus::Transform4::get_translation() const -> const Point3&{
-  return *reinterpret_cast<const Point3*>(n_[3].data());
-}
+  explicit Affine(const morpheus::Transform4& h) {
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 4; ++col) m[4 * row + col] = h(row, col);
+    }
+  }
+};
 
-void morpheus::Transform4::set_translation(const Point3& p) {
-  n_[3][0] = p.x();
-  n_[3][1] = p.y();
-  n_[3][2] = p.z();
-}
+}  // namespace
 
 auto morpheus::inverse(const Transform4& h) -> Transform4 {
   const Vector3& a = h[0];
@@ -72,31 +58,136 @@ auto morpheus::inverse(const Transform4& h) -> Transform4 {
           { s.x(),  s.y(),  s.z(),  -dot(d, s)    }};
 }
 
+auto morpheus::get_normal_matrix(const Transform4& h) -> Matrix3 {
+  // columns of the inverse transpose, rows of the inverse
+  Vector3 r0 = cross(h[1], h[2]);
+  Vector3 r1 = cross(h[2], h[0]);
+  Vector3 r2 = cross(h[0], h[1]);
+
+  // singular like in the batch kernels
+  float det = dot(h[0], r0);
+  if (std::abs(det) <= singular_tolerance * h[0].magnitude() * h[1].magnitude() * h[2].magnitude()) return {};
+
+  float inv_det = 1.0F / det;
+  return {r0 * inv_det, r1 * inv_det, r2 * inv_det};
+}
+
+void morpheus::compose(const Transform4& a, const Transform4& b, Transform4& out) {
+  // column j of a * b is the linear part of a times column j of b, plus the
+  // translation of a for j = 3 (the bottom row of b is 0, 0, 0, 1). the bottom row
+  // of the result comes out as 0, 0, 0, 1 as well. all columns are computed before
+  // storing anything so that out may alias a or b
+#if defined(MORPHEUS_AVX)
+  // two result columns per 256-bit register
+  __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[0].data()));
+  __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[1].data()));
+  __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a[2].data()));
+
+  __m256 r[2];
+  for (int i = 0; i < 2; ++i) {
+    __m256 c = _mm256_loadu_ps(b.data() + 8 * i);
+#if defined(MORPHEUS_FMA)
+    r[i] = _mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00));
+    r[i] = _mm256_fmadd_ps(a1, _mm256_permute_ps(c, 0x55), r[i]);
+    r[i] = _mm256_fmadd_ps(a2, _mm256_permute_ps(c, 0xAA), r[i]);
+#else
+    r[i] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a0, _mm256_permute_ps(c, 0x00)),
+                                       _mm256_mul_ps(a1, _mm256_permute_ps(c, 0x55))),
+                         _mm256_mul_ps(a2, _mm256_permute_ps(c, 0xAA)));
+#endif
+  }
+  // translation into the upper half, which holds column 3
+  __m128 a3 = _mm_load_ps(a.data() + 12);
+  r[1] = _mm256_add_ps(r[1], _mm256_insertf128_ps(_mm256_setzero_ps(), a3, 1));
+
+  _mm256_storeu_ps(out.data(), r[0]);
+  _mm256_storeu_ps(out.data() + 8, r[1]);
+#elif defined(MORPHEUS_SSE)
+  __m128 a0 = _mm_load_ps(a.data());
+  __m128 a1 = _mm_load_ps(a.data() + 4);
+  __m128 a2 = _mm_load_ps(a.data() + 8);
+  __m128 a3 = _mm_load_ps(a.data() + 12);
+
+  __m128 r[4];
+  for (int col = 0; col < 4; ++col) {
+    const float* c = b.data() + 4 * col;
+    r[col] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(c[0])), _mm_mul_ps(a1, _mm_set1_ps(c[1]))),
+                        _mm_mul_ps(a2, _mm_set1_ps(c[2])));
+  }
+  r[3] = _mm_add_ps(r[3], a3);
+  for (int col = 0; col < 4; ++col) _mm_store_ps(out.data() + 4 * col, r[col]);
+#else
+  float r[3][4];
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      r[row][col] = a(row, 0) * b(0, col) + a(row, 1) * b(1, col) + a(row, 2) * b(2, col);
+    }
+    r[row][3] += a(row, 3);
+  }
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) out(row, col) = r[row][col];
+  }
+  out(3, 0) = out(3, 1) = out(3, 2) = 0.0F;
+  out(3, 3) = 1.0F;
+#endif
+}
+
 auto morpheus::operator*(const Transform4& a, const Transform4& b) -> Transform4 {
-  return {
-    { a(0, 0) * b(0, 0) + a(0, 1) * b(1, 0) + a(0, 2) * b(2, 0),
-      a(0, 0) * b(0, 1) + a(0, 1) * b(1, 1) + a(0, 2) * b(2, 1),
-      a(0, 0) * b(0, 2) + a(0, 1) * b(1, 2) + a(0, 2) * b(2, 2),
-      a(0, 0) * b(0, 3) + a(0, 1) * b(1, 3) + a(0, 2) * b(2, 3) + a(0, 3) },
-    { a(1, 0) * b(0, 0) + a(1, 1) * b(1, 0) + a(1, 2) * b(2, 0),
-      a(1, 0) * b(0, 1) + a(1, 1) * b(1, 1) + a(1, 2) * b(2, 1),
-      a(1, 0) * b(0, 2) + a(1, 1) * b(1, 2) + a(1, 2) * b(2, 2),
-      a(1, 0) * b(0, 3) + a(1, 1) * b(1, 3) + a(1, 2) * b(2, 3) + a(1, 3) },
-    { a(2, 0) * b(0, 0) + a(2, 1) * b(1, 0) + a(2, 2) * b(2, 0),
-      a(2, 0) * b(0, 1) + a(2, 1) * b(1, 1) + a(2, 2) * b(2, 1),
-      a(2, 0) * b(0, 2) + a(2, 1) * b(1, 2) + a(2, 2) * b(2, 2),
-      a(2, 0) * b(0, 3) + a(2, 1) * b(1, 3) + a(2, 2) * b(2, 3) + a(2, 3)}
-  };
+  Transform4 tmp;
+  compose(a, b, tmp);
+  return tmp;
+}
+
+void morpheus::compose_batch(span<const Transform4> a, span<const Transform4> b, span<Transform4> out) {
+  assert(b.size() == a.size() && out.size() >= a.size());
+  get_batch_kernels().compose(reinterpret_cast<const float*>(a.data()), reinterpret_cast<const float*>(b.data()),
+                              reinterpret_cast<float*>(out.data()), a.size());
+}
+
+void morpheus::get_normal_matrices(span<const Transform4> in, span<Matrix3> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().normal_matrices(reinterpret_cast<const float*>(in.data()),
+                                      reinterpret_cast<float*>(out.data()), in.size());
+}
+
+void morpheus::transform_points(const Transform4& h, span<const Point3> in, span<Point3> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().transform_points(Affine(h).m, reinterpret_cast<const float*>(in.data()),
+                                       reinterpret_cast<float*>(out.data()), in.size());
+}
+
+void morpheus::transform_vectors(const Transform4& h, span<const Vector3> in, span<Vector3> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().transform_vectors(Affine(h).m, reinterpret_cast<const float*>(in.data()),
+                                        reinterpret_cast<float*>(out.data()), in.size());
+}
+
+void morpheus::transform_points(const Transform4& h, Stream3<const float> in, Stream3<float> out) {
+  assert(in.y.size() == in.size() && in.z.size() == in.size());
+  assert(out.x.size() >= in.size() && out.y.size() >= in.size() && out.z.size() >= in.size());
+
+  const float* const src[3] = { in.x.data(), in.y.data(), in.z.data() };
+  float* const dst[3] = { out.x.data(), out.y.data(), out.z.data() };
+  get_batch_kernels().transform_points_soa(Affine(h).m, src, dst, in.size());
 }
 
-auto morpheus::operator*(const Transform4& h, const Vector3& v) -> Vector3 {
-  return { h(0, 0) * v.x() + h(0, 1) * v.y() + h(0, 2) * v.z(),
-           h(1, 0) * v.x() + h(1, 1) * v.y() + h(1, 2) * v.z(),
-           h(2, 0) * v.x() + h(2, 1) * v.y() + h(2, 2) * v.z() };
+void morpheus::transform_vectors(const Transform4& h, Stream3<const float> in, Stream3<float> out) {
+  assert(in.y.size() == in.size() && in.z.size() == in.size());
+  assert(out.x.size() >= in.size() && out.y.size() >= in.size() && out.z.size() >= in.size());
+
+  const float* const src[3] = { in.x.data(), in.y.data(), in.z.data() };
+  float* const dst[3] = { out.x.data(), out.y.data(), out.z.data() };
+  get_batch_kernels().transform_vectors_soa(Affine(h).m, src, dst, in.size());
 }
 
-auto morpheus::operator*(const Transform4& h, const Point3& p) -> Point3 {
-  return { h(0, 0) * p.x() + h(0, 1) * p.y() + h(0, 2) * p.z() + h(0, 3),
-           h(1, 0) * p.x() + h(1, 1) * p.y() + h(1, 2) * p.z() + h(1, 3),
-           h(2, 0) * p.x() + h(2, 1) * p.y() + h(2, 2) * p.z() + h(2, 3) };
-}
\ No newline at end of file
+void morpheus::transform_points(const Transform4& h, span<const Vector3A> in, span<Vector3A> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().transform_points_padded(h.data(), reinterpret_cast<const float*>(in.data()),
+                                              reinterpret_cast<float*>(out.data()), in.size());
+}
+
+void morpheus::transform_vectors(const Transform4& h, span<const Vector3A> in, span<Vector3A> out) {
+  assert(out.size() >= in.size());
+  get_batch_kernels().transform_vectors_padded(h.data(), reinterpret_cast<const float*>(in.data()),
+                                               reinterpret_cast<float*>(out.data()), in.size());
+}
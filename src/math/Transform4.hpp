@@ -1,9 +1,18 @@
 #ifndef MORPHEUS_TRANSFORM4_HPP
 #define MORPHEUS_TRANSFORM4_HPP
 
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "Expression.hpp"
+#include "Matrix3.hpp"
 #include "Matrix4.hpp"
-#include "Vector3.hpp"
 #include "Point3.hpp"
+#include "Span.hpp"
+#include "Vector3.hpp"
+#include "Vector3A.hpp"
 
 using initializer_list_float = std::initializer_list<std::initializer_list<float>>;
 
@@ -12,8 +21,8 @@ namespace morpheus {
 class Transform4: public Matrix4 {
  public:
   Transform4() = default;
-  Transform4(initializer_list_float init_list);
-  Transform4(const Vector3& a, const Vector3& b, const Vector3& c, const Point3& p);
+  constexpr Transform4(initializer_list_float init_list);
+  constexpr Transform4(const Vector3& a, const Vector3& b, const Vector3& c, const Point3& p);
 
   auto operator[](int j) -> Vector3&;
   auto operator[](int j) const -> const Vector3&;
@@ -22,11 +31,114 @@ class Transform4: public Matrix4 {
   void set_translation(const Point3& p);
 };
 
+constexpr Transform4::Transform4(initializer_list_float init_list) {
+  assert(init_list.size() == 3);
+
+  int row = 0;
+  int col = 0;
+  for (auto sublist : init_list) {
+    assert(sublist.size() == 4);
+    for (float element : sublist) {
+      // changed order from conventional row, col to col, row
+      // to support subscript operator[] -> Vector3&
+      n_[col][row] = element;
+      ++col;
+    }
+    col = 0;
+    ++row;
+  }
+  n_[0][3] = n_[1][3] = n_[2][3] = 0.0F; n_[3][3] = 1.0F;
+}
+
+constexpr Transform4::Transform4(const Vector3& a, const Vector3& b, const Vector3& c, const Point3& p) {
+  n_[0][0] = a.x(); n_[0][1] = a.y(); n_[0][2] = a.z();
+  n_[1][0] = b.x(); n_[1][1] = b.y(); n_[1][2] = b.z();
+  n_[2][0] = c.x(); n_[2][1] = c.y(); n_[2][2] = c.z();
+  n_[3][0] = p.x(); n_[3][1] = p.y(); n_[3][2] = p.z();
+
+  n_[0][3] = n_[1][3] = n_[2][3] = 0.0F; n_[3][3] = 1.0F;
+}
+
+inline auto Transform4::operator[](int j) -> Vector3& {
+  return *reinterpret_cast<Vector3*>(n_[j].data());
+}
+
+inline auto Transform4::operator[](int j) const -> const Vector3& {
+  return *reinterpret_cast<const Vector3*>(n_[j].data());
+}
+
+inline auto Transform4::get_translation() const -> const Point3&{
+  return *reinterpret_cast<const Point3*>(n_[3].data());
+}
+
+inline void Transform4::set_translation(const Point3& p) {
+  n_[3][0] = p.x();
+  n_[3][1] = p.y();
+  n_[3][2] = p.z();
+}
+
 auto inverse(const Transform4& h) -> Transform4;
 
+// inverse transpose of the upper 3x3 block, transforms normals so that they stay
+// perpendicular to transformed surfaces under non-uniform scale. the zero matrix
+// if the block is singular, i.e. |det| is at most 1e-6 times the product of its
+// column lengths (like get_normal_matrices and inverse_batch in Matrix4.hpp)
+auto get_normal_matrix(const Transform4& h) -> Matrix3;
+
+// out = a * b written directly into out, which may alias a or b. affine, so
+// 3x4 elements are computed instead of 4x4
+void compose(const Transform4& a, const Transform4& b, Transform4& out);
+
 auto operator*(const Transform4& a, const Transform4& b) -> Transform4;
-auto operator*(const Transform4& h, const Vector3& v) -> Vector3;
-auto operator*(const Transform4& h, const Point3& p) -> Point3;
+
+inline auto operator*(const Transform4& h, const Vector3& v) -> Vector3 {
+  return { h(0, 0) * v.x() + h(0, 1) * v.y() + h(0, 2) * v.z(),
+           h(1, 0) * v.x() + h(1, 1) * v.y() + h(1, 2) * v.z(),
+           h(2, 0) * v.x() + h(2, 1) * v.y() + h(2, 2) * v.z() };
+}
+
+inline auto operator*(const Transform4& h, const Point3& p) -> Point3 {
+  return { h(0, 0) * p.x() + h(0, 1) * p.y() + h(0, 2) * p.z() + h(0, 3),
+           h(1, 0) * p.x() + h(1, 1) * p.y() + h(1, 2) * p.z() + h(1, 3),
+           h(2, 0) * p.x() + h(2, 1) * p.y() + h(2, 2) * p.z() + h(2, 3) };
+}
+
+// evaluates an expression first and transforms it as a point or a vector, depending on what it yields
+template <typename E, typename = typename std::enable_if<is_expression_of<E, 3, Vector3, Point3>::value>::type>
+auto operator*(const Transform4& h, const E& e) -> expression_result<E> {
+  return h * expression_result<E>(e);
+}
+
+// structure-of-arrays view on a stream of 3d points or vectors
+template <typename T>
+struct Stream3 {
+  span<T> x, y, z;
+
+  auto size() const -> std::size_t { return x.size(); }
+};
+
+// batched versions of operator* that write into caller-provided buffers, using
+// the kernels of the current simd level (see Dispatch.hpp).
+// out must hold at least as many elements as in, and may alias in
+void transform_points(const Transform4& h, span<const Point3> in, span<Point3> out);
+void transform_vectors(const Transform4& h, span<const Vector3> in, span<Vector3> out);
+void transform_points(const Transform4& h, Stream3<const float> in, Stream3<float> out);
+void transform_vectors(const Transform4& h, Stream3<const float> in, Stream3<float> out);
+
+// padded vectors (see Vector3A.hpp) are loaded and stored whole, in is transformed
+// as points or as vectors
+void transform_points(const Transform4& h, span<const Vector3A> in, span<Vector3A> out);
+void transform_vectors(const Transform4& h, span<const Vector3A> in, span<Vector3A> out);
+
+// out[i] = a[i] * b[i] with the kernels of the current simd level, e.g. for
+// composing parent and local transforms of a scene level. a and b have the same
+// size, out must hold at least as many elements and may alias a or b
+void compose_batch(span<const Transform4> a, span<const Transform4> b, span<Transform4> out);
+
+// normal matrices of in[i] written to out[i] with the kernels of the current simd
+// level, zero for transforms with a singular 3x3 block like get_normal_matrix.
+// out must hold at least as many elements as in
+void get_normal_matrices(span<const Transform4> in, span<Matrix3> out);
 
 }  // namespace morpheus
 
@@ -0,0 +1,244 @@
+#ifndef MORPHEUS_VECTOR_HPP
+#define MORPHEUS_VECTOR_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "Expression.hpp"
+#include "Precision.hpp"
+#include "Simd.hpp"
+
+namespace morpheus {
+
+// calls f(0), f(1), .., f(N - 1), unrolled at compile time
+template <std::size_t N>
+struct unroll {
+  template <typename F>
+  static constexpr void apply(F&& f) {
+    unroll<N - 1>::apply(f);
+    f(N - 1);
+  }
+};
+
+template <>
+struct unroll<0> {
+  template <typename F>
+  static constexpr void apply(F&&) {}
+};
+
+// vectors that fill a sse register are 16-byte aligned so that simd kernels can
+// use aligned loads/stores
+template <typename T, std::size_t N>
+struct vector_alignment {
+  static const std::size_t value = alignof(T);
+};
+
+template <>
+struct vector_alignment<float, 4> {
+  static const std::size_t value = 16;
+};
+
+// component-wise kernels behind the vector operators. the generic version is
+// unrolled at compile time, simd versions are specializations for a scalar type
+// and size
+template <typename T, std::size_t N>
+struct vector_kernels {
+  static constexpr void add(T* a, const T* b) {
+    unroll<N>::apply([&](std::size_t i) { a[i] += b[i]; });
+  }
+
+  static constexpr void subtract(T* a, const T* b) {
+    unroll<N>::apply([&](std::size_t i) { a[i] -= b[i]; });
+  }
+
+  static constexpr void multiply(T* a, T s) {
+    unroll<N>::apply([&](std::size_t i) { a[i] *= s; });
+  }
+
+  static constexpr void divide(T* a, T s) {
+    unroll<N>::apply([&](std::size_t i) { a[i] /= s; });
+  }
+
+  static constexpr auto dot(const T* a, const T* b) -> T {
+    T sum = T();
+    unroll<N>::apply([&](std::size_t i) { sum += a[i] * b[i]; });
+    return sum;
+  }
+};
+
+#if defined(MORPHEUS_SSE)
+// one sse register per vector
+template <>
+struct vector_kernels<float, 4> {
+  static void add(float* a, const float* b) { _mm_store_ps(a, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b))); }
+  static void subtract(float* a, const float* b) { _mm_store_ps(a, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b))); }
+  static void multiply(float* a, float s) { _mm_store_ps(a, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(s))); }
+  static void divide(float* a, float s) { _mm_store_ps(a, _mm_div_ps(_mm_load_ps(a), _mm_set1_ps(s))); }
+
+  static auto dot(const float* a, const float* b) -> float {
+#if defined(MORPHEUS_SSE4_1)
+    return _mm_cvtss_f32(_mm_dp_ps(_mm_load_ps(a), _mm_load_ps(b), 0xF1));
+#else
+    // horizontal sum of the component-wise product: (x+z, y+w, ..) then (x+z + y+w)
+    __m128 p = _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b));
+    __m128 s = _mm_add_ps(p, _mm_movehl_ps(p, p));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(s);
+#endif
+  }
+};
+#endif
+
+template <typename T, std::size_t N>
+class Vector;
+
+// true if E is an expression of the same size and scalar type as V that evaluates
+// to V or to a type derived from it (e.g. a Point3 converts to a Vector3)
+template <typename E, typename V>
+struct evaluates_to {
+  static const bool value = expression_traits<E>::value && expression_traits<E>::size == V::size
+                            && std::is_same<expression_value<E>, typename V::value_type>::value
+                            && std::is_base_of<V, expression_result<E>>::value;
+};
+
+// N-component vector of T, float, double or Fixed (see Fixed.hpp).
+// defined inline so that loops over vectors can be inlined and vectorized,
+// constexpr so that constant vectors are built at compile time (except where
+// a simd kernel is used, e.g. arithmetic on Vector4),
+// arithmetic operators build lazy expressions (see Expression.hpp)
+template <typename T, std::size_t N>
+class alignas(vector_alignment<T, N>::value) Vector {
+ protected:
+  T n_[N]{};
+
+ public:
+  using value_type = T;
+  static const std::size_t size = N;
+
+  Vector() = default;
+
+  // components in order, missing trailing components are zero (Vector4(x, y, z) has w = 0)
+  template <typename... Args, typename = typename std::enable_if<(sizeof...(Args) > 1 && sizeof...(Args) <= N)>::type>
+  constexpr Vector(Args... args) : n_{static_cast<T>(args)...} {}
+
+  // evaluates an expression in a single pass
+  template <typename E, typename = typename std::enable_if<evaluates_to<E, Vector>::value>::type>
+  constexpr Vector(const E& e) {
+    unroll<N>::apply([&](std::size_t i) { n_[i] = e[i]; });
+  }
+
+  template <typename E>
+  constexpr auto operator=(const E& e) -> typename std::enable_if<evaluates_to<E, Vector>::value, Vector&>::type {
+    unroll<N>::apply([&](std::size_t i) { n_[i] = e[i]; });
+    return *this;
+  }
+
+  constexpr auto x() const -> T { return n_[0]; }
+  constexpr auto y() const -> T { return n_[1]; }
+
+  constexpr auto z() const -> T {
+    static_assert(N > 2, "vector has no z component");
+    return n_[2];
+  }
+
+  constexpr auto w() const -> T {
+    static_assert(N > 3, "vector has no w component");
+    return n_[3];
+  }
+
+  constexpr auto operator[](unsigned int i) -> T& { return n_[i]; }
+  constexpr auto operator[](unsigned int i) const -> const T& { return n_[i]; }
+
+  constexpr auto data() -> T* { return n_; }
+  constexpr auto data() const -> const T* { return n_; }
+
+  constexpr auto operator*=(T s) -> Vector& {
+    vector_kernels<T, N>::multiply(n_, s);
+    return *this;
+  }
+
+  constexpr auto operator/=(T s) -> Vector& {
+    assert(s != T(0));
+
+    vector_kernels<T, N>::divide(n_, s);
+    return *this;
+  }
+
+  constexpr auto operator+=(const Vector& v) -> Vector& {
+    vector_kernels<T, N>::add(n_, v.n_);
+    return *this;
+  }
+
+  constexpr auto operator-=(const Vector& v) -> Vector& {
+    vector_kernels<T, N>::subtract(n_, v.n_);
+    return *this;
+  }
+
+  auto magnitude() const -> T {
+    using std::sqrt;
+    return sqrt(dot(*this));
+  }
+
+  // fast multiplies by an approximate reciprocal length (see Precision.hpp)
+  template <typename P = default_precision>
+  auto normalize() -> Vector& {
+    if constexpr (std::is_same<P, precision::fast>::value) {
+      *this *= rsqrt<P>(dot(*this));
+    } else {
+      *this /= magnitude();
+    }
+    return *this;
+  }
+
+  constexpr auto dot(const Vector& v) const -> T { return vector_kernels<T, N>::dot(n_, v.n_); }
+
+  constexpr auto project(const Vector& v) -> Vector& {
+    *this = v * (dot(v) / v.dot(v));
+    return *this;
+  }
+
+  constexpr auto reject(const Vector& v) -> Vector& {
+    *this -= v * (dot(v) / v.dot(v));
+    return *this;
+  }
+};
+
+template <typename T, std::size_t N>
+struct expression_traits<Vector<T, N>> {
+  static const bool value = true;
+  static const std::size_t size = N;
+  using value_type = T;
+  using result = Vector<T, N>;
+  using operand = const Vector<T, N>&;
+};
+
+template <typename T, std::size_t N>
+inline auto magnitude(const Vector<T, N>& v) -> T { return v.magnitude(); }
+
+template <typename P = default_precision, typename T, std::size_t N>
+inline auto normalize(Vector<T, N> v) -> Vector<T, N> {
+  v.template normalize<P>();
+  return v;
+}
+
+template <typename T, std::size_t N>
+constexpr auto dot(const Vector<T, N>& a, const Vector<T, N>& b) -> T { return a.dot(b); }
+
+template <typename T>
+constexpr auto cross(const Vector<T, 3>& a, const Vector<T, 3>& b) -> Vector<T, 3> {
+  return {a.y() * b.z() - a.z() * b.y(),
+          a.z() * b.x() - a.x() * b.z(),
+          a.x() * b.y() - a.y() * b.x()};
+}
+
+template <typename T, std::size_t N>
+constexpr auto project(Vector<T, N> a, const Vector<T, N>& b) -> Vector<T, N> { return a.project(b); }
+
+template <typename T, std::size_t N>
+constexpr auto reject(Vector<T, N> a, const Vector<T, N>& b) -> Vector<T, N> { return a.reject(b); }
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_VECTOR_HPP
@@ -1,57 +1,19 @@
 #ifndef MORPHEUS_VECTOR3_HPP
 #define MORPHEUS_VECTOR3_HPP
 
-#include <cassert>
+#include "Span.hpp"
+#include "Vector.hpp"
 
 namespace morpheus {
 
-struct Vector3 {
- protected:
-  float x_{0}, y_{0}, z_{0};
+class Point3;
 
- public:
-  Vector3() = default;
-  Vector3(float x, float y, float z) : x_(x), y_(y), z_(z) {}
+using Vector3 = Vector<float, 3>;
 
-  auto x() const -> float { return x_; }
-  auto y() const -> float { return y_; }
-  auto z() const -> float { return z_; }
-
-  auto operator[](unsigned int i) -> float&;
-  auto operator[](unsigned int i) const -> const float& { return (*this)[i]; }
-
-  auto operator*=(float s) -> Vector3&;
-  auto operator/=(float s) -> Vector3&;
-
-  auto operator+=(const Vector3& v) -> Vector3&;
-  auto operator-=(const Vector3& v) -> Vector3&;
-
-  auto magnitude() const -> float { return sqrt(x_ * x_ + y_ * y_ + z_ * z_); }
-  auto normalize() -> Vector3&;
-
-  auto dot(const Vector3& v) const -> float;
-
-  auto project(const Vector3& v) -> Vector3&;
-  auto reject(const Vector3& v) -> Vector3&;
-};
-
-auto operator*(Vector3 v, float s) -> Vector3;
-auto operator/(Vector3 v, float s) -> Vector3;
-
-auto operator-(Vector3 v) -> Vector3;
-
-auto operator+(Vector3 a, const Vector3& b) -> Vector3;
-auto operator-(Vector3 a, const Vector3& b) -> Vector3;
-
-inline auto magnitude(const Vector3& v) -> float { return v.magnitude(); }
-auto normalize(Vector3 v) -> Vector3;
-
-inline auto dot(const Vector3& a, const Vector3& b) -> float { return a.dot(b); }
-auto cross(const Vector3& a, const Vector3& b) -> Vector3;
-
-inline auto project(Vector3 a, const Vector3& b) -> Vector3 { return a.project(b); }
-inline auto reject(Vector3 a, const Vector3& b) -> Vector3 { return a.reject(b); }
+// normalizes in[i] into out[i] with the kernels of the current simd level
+// (see Dispatch.hpp). out must hold at least as many elements as in, and may alias in
+void normalize_batch(span<const Vector3> in, span<Vector3> out);
 
 }  // namespace morpheus
 
-#endif  // MORPHEUS_VECTOR3_HPP
\ No newline at end of file
+#endif  // MORPHEUS_VECTOR3_HPP
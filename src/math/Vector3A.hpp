@@ -0,0 +1,82 @@
+#ifndef MORPHEUS_VECTOR3A_HPP
+#define MORPHEUS_VECTOR3A_HPP
+
+#include <type_traits>
+
+#include "Expression.hpp"
+#include "Simd.hpp"
+#include "Vector3.hpp"
+
+namespace morpheus {
+
+// Vector3 padded to 16 bytes and aligned like a Vector4, so that one aligned sse
+// load or store moves a whole vector and arrays of it need no shuffles (see the
+// Vector3A overloads of transform_points/vectors in Transform4.hpp).
+// derived from Vector3 like Point3: works with every Vector3 operation and binds
+// to a const Vector3& without a copy. the padding is never read as a component,
+// the constructors and batch kernels keep it at zero
+class alignas(16) Vector3A: public Vector3 {
+ private:
+  float pad_{0.0F};
+
+ public:
+  Vector3A() = default;
+  constexpr Vector3A(float a, float b, float c) : Vector3(a, b, c) {}
+  constexpr Vector3A(const Vector3& v) : Vector3(v) {}
+
+  // evaluates an expression that yields a vector, e.g. a + b * t
+  template <typename E, typename = typename std::enable_if<evaluates_to<E, Vector3>::value>::type>
+  constexpr Vector3A(const E& e) : Vector3(e[0], e[1], e[2]) {}
+
+  constexpr auto operator=(const Vector3& v) -> Vector3A& {
+    Vector3::operator=(v);
+    return *this;
+  }
+
+  template <typename E>
+  constexpr auto operator=(const E& e) -> typename std::enable_if<evaluates_to<E, Vector3>::value, Vector3A&>::type {
+    Vector3::operator=(e);
+    return *this;
+  }
+};
+
+template <>
+struct expression_traits<Vector3A> {
+  static const bool value = true;
+  static const std::size_t size = 3;
+  using value_type = float;
+  using result = Vector3;
+  using operand = const Vector3A&;
+};
+
+#if defined(MORPHEUS_SSE)
+// both operands are single aligned loads, the padding lane is left out of the sum
+inline auto dot(const Vector3A& a, const Vector3A& b) -> float {
+  __m128 va = _mm_load_ps(a.data());
+  __m128 vb = _mm_load_ps(b.data());
+#if defined(MORPHEUS_SSE4_1)
+  return _mm_cvtss_f32(_mm_dp_ps(va, vb, 0x71));
+#else
+  __m128 p = _mm_mul_ps(va, vb);
+  __m128 s = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehl_ps(p, p)));
+#endif
+}
+
+// (a.yzx * b.zxy - a.zxy * b.yzx), computed as (a * b.yzx - a.yzx * b).yzx with
+// three shuffles instead of four. the padding lane comes out as zero
+inline auto cross(const Vector3A& a, const Vector3A& b) -> Vector3A {
+  __m128 va = _mm_load_ps(a.data());
+  __m128 vb = _mm_load_ps(b.data());
+  __m128 a_yzx = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 b_yzx = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 c = _mm_sub_ps(_mm_mul_ps(va, b_yzx), _mm_mul_ps(a_yzx, vb));
+  Vector3A r;
+  _mm_store_ps(r.data(), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+  return r;
+}
+#endif
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_VECTOR3A_HPP
@@ -0,0 +1,97 @@
+#ifndef MORPHEUS_VECTOR_FIXED_HPP
+#define MORPHEUS_VECTOR_FIXED_HPP
+
+#include <cstdint>
+
+#include "Fixed.hpp"
+#include "Vector.hpp"
+#include "Vector4.hpp"
+
+namespace morpheus {
+
+// window coordinates snapped to a grid of 256 subpixels per pixel (24.8 fixed
+// point), so that vertices shared by triangles land on exactly the same position
+// and integer edge functions are watertight
+using Subpixel = Fixed<8>;
+
+// window position and depth in 24.8
+using Vector3fx = Vector<Subpixel, 3>;
+
+// window position in subpixels (raw 24.8 values), the input of integer triangle setup
+using Vector2i = Vector<std::int32_t, 2>;
+
+// overflow-checked integer arithmetic, r is only valid if true is returned
+template <typename T>
+constexpr auto checked_add(T a, T b, T& r) -> bool { return !__builtin_add_overflow(a, b, &r); }
+
+template <typename T>
+constexpr auto checked_subtract(T a, T b, T& r) -> bool { return !__builtin_sub_overflow(a, b, &r); }
+
+template <typename T>
+constexpr auto checked_multiply(T a, T b, T& r) -> bool { return !__builtin_mul_overflow(a, b, &r); }
+
+constexpr auto checked_subtract(const Vector2i& a, const Vector2i& b, Vector2i& r) -> bool {
+  return checked_subtract(a.x(), b.x(), r[0]) && checked_subtract(a.y(), b.y(), r[1]);
+}
+
+// a.x * b.y - a.y * b.x, exact in 64 bits for any 32-bit components
+constexpr auto cross(const Vector2i& a, const Vector2i& b) -> std::int64_t {
+  return std::int64_t(a.x()) * b.y() - std::int64_t(a.y()) * b.x();
+}
+
+// twice the signed area of the triangle v0 v1 v2 in subpixels squared, positive if
+// the vertices are clockwise on screen (counter-clockwise with y up)
+constexpr auto checked_area(const Vector2i& v0, const Vector2i& v1, const Vector2i& v2, std::int64_t& r) -> bool {
+  Vector2i e0, e1;
+  if (!checked_subtract(v1, v0, e0) || !checked_subtract(v2, v0, e1)) return false;
+  r = cross(e0, e1);
+  return true;
+}
+
+// e(p) = a * p.x + b * p.y + c of the directed edge v0 -> v1, zero on the edge and
+// positive on the side where checked_area is positive
+struct EdgeFunction {
+  std::int32_t a{0};
+  std::int32_t b{0};
+  std::int64_t c{0};
+
+  constexpr auto evaluate(const Vector2i& p, std::int64_t& r) const -> bool {
+    std::int64_t ax = std::int64_t(a) * p.x();
+    std::int64_t by = std::int64_t(b) * p.y();
+    return checked_add(ax, by, r) && checked_add(r, c, r);
+  }
+};
+
+constexpr auto make_edge_function(const Vector2i& v0, const Vector2i& v1, EdgeFunction& e) -> bool {
+  if (!checked_subtract(v0.y(), v1.y(), e.a) || !checked_subtract(v1.x(), v0.x(), e.b)) return false;
+  e.c = cross(v0, v1);
+  return true;
+}
+
+// maps the clip-space position p (the output of a projection, before the divide by w)
+// to a width x height viewport, x right and y down from the top-left corner, and
+// depth from [0, 1] to [0, depth_scale). false if p is on or behind the eye plane
+// (w <= 0) or a coordinate doesn't fit in 24.8
+inline auto to_window(const Vector4& p, float width, float height, Vector3fx& out, float depth_scale = 65536.0F)
+    -> bool {
+  if (!(p.w() > 0.0F)) return false;
+
+  float inv_w = 1.0F / p.w();
+  float x = (p.x() * inv_w + 1.0F) * 0.5F * width;
+  float y = (1.0F - p.y() * inv_w) * 0.5F * height;
+  float z = p.z() * inv_w * depth_scale;
+
+  // also false for nan
+  Subpixel sx, sy, sz;
+  if (!Subpixel::checked_convert(x, sx) || !Subpixel::checked_convert(y, sy) || !Subpixel::checked_convert(z, sz)) {
+    return false;
+  }
+  out = Vector3fx(sx, sy, sz);
+  return true;
+}
+
+constexpr auto to_subpixel(const Vector3fx& p) -> Vector2i { return {p.x().raw(), p.y().raw()}; }
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_VECTOR_FIXED_HPP
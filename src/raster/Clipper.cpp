@@ -0,0 +1,165 @@
+#include "Clipper.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+#include <math/Projection.hpp>
+#include <math/Simd.hpp>
+#include <math/Vector4.hpp>
+
+namespace {
+
+using morpheus::DepthRange;
+using morpheus::Vector4;
+
+// outcode bits, the planes of the view volume and the sides of the guard band. in
+// the lane order of x, y, z so that sse compares produce them directly
+const unsigned left_plane = 1;
+const unsigned bottom_plane = 2;
+const unsigned near_plane = 4;
+const unsigned right_plane = 8;
+const unsigned top_plane = 16;
+const unsigned far_plane = 32;
+const unsigned guard_left = 64;
+const unsigned guard_bottom = 128;
+const unsigned guard_right = 256;
+const unsigned guard_top = 512;
+const unsigned guard_far = 1024;
+
+const unsigned view_planes = near_plane | far_plane | left_plane | right_plane | bottom_plane | top_plane;
+const unsigned clip_planes = near_plane | guard_left | guard_right | guard_bottom | guard_top | guard_far;
+const unsigned clip_plane_list[] = {near_plane, guard_left, guard_bottom, guard_right, guard_top, guard_far};
+
+// each clip plane adds at most one vertex
+const int max_vertices = 3 + 6;
+
+// window x is (x / w + 1) * width / 2, within [width - guard_band, guard_band] for
+// |x| * width <= (2 * guard_band - width) * w, which needs no division. same for y.
+// reversed depth is tested as w - z, which puts the near plane at 0 and the far
+// plane at w like standard depth
+struct GuardBand {
+  float width;
+  float height;
+  float x;
+  float y;
+  bool reversed;
+
+  GuardBand(int w, int h, DepthRange range)
+      : width(static_cast<float>(w)), height(static_cast<float>(h)), x(2.0F * morpheus::guard_band - width),
+        y(2.0F * morpheus::guard_band - height), reversed(range == DepthRange::reversed) {
+    assert(w < morpheus::guard_band && h < morpheus::guard_band);
+  }
+
+  auto get_depth(const Vector4& p) const -> float { return reversed ? p.w() - p.z() : p.z(); }
+};
+
+auto get_outcode(const Vector4& p, const GuardBand& g) -> unsigned {
+#if defined(MORPHEUS_SSE)
+  // x, y and z against -w, -w and 0, and against w. x * width, y * height and z
+  // against the guard band (only above it for z), the last lane compares zeros
+  __m128 v = _mm_load_ps(p.data());
+  if (g.reversed) v = _mm_setr_ps(p.x(), p.y(), g.get_depth(p), p.w());
+  __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128 s = _mm_mul_ps(v, _mm_setr_ps(g.width, g.height, 1.0F, 0.0F));
+  __m128 band = _mm_mul_ps(w, _mm_setr_ps(g.x, g.y, morpheus::depth_guard_band, 0.0F));
+  __m128 low = _mm_mul_ps(w, _mm_setr_ps(-1.0F, -1.0F, 0.0F, 0.0F));
+  unsigned below = static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(v, low)));
+  unsigned above = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(v, w)));
+  unsigned band_below = static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(s, _mm_sub_ps(_mm_setzero_ps(), band))));
+  unsigned band_above = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(s, band)));
+  return (below & 7) | (above & 7) << 3 | (band_below & 3) << 6 | (band_above & 7) << 8;
+#else
+  float x = p.x();
+  float y = p.y();
+  float z = g.get_depth(p);
+  float w = p.w();
+  return (x < -w ? left_plane : 0) | (y < -w ? bottom_plane : 0) | (z < 0.0F ? near_plane : 0) |
+         (x > w ? right_plane : 0) | (y > w ? top_plane : 0) | (z > w ? far_plane : 0) |
+         (x * g.width < -g.x * w ? guard_left : 0) | (y * g.height < -g.y * w ? guard_bottom : 0) |
+         (x * g.width > g.x * w ? guard_right : 0) | (y * g.height > g.y * w ? guard_top : 0) |
+         (z > morpheus::depth_guard_band * w ? guard_far : 0);
+#endif
+}
+
+// >= 0 on the inner side of the plane, scaled by a positive factor for the guard
+// band, which doesn't move the intersections
+auto distance(unsigned plane, const Vector4& p, const GuardBand& g) -> float {
+  switch (plane) {
+    case near_plane: return g.get_depth(p);
+    case guard_left: return g.x * p.w() + p.x() * g.width;
+    case guard_right: return g.x * p.w() - p.x() * g.width;
+    case guard_bottom: return g.y * p.w() + p.y() * g.height;
+    case guard_top: return g.y * p.w() - p.y() * g.height;
+    case guard_far: return morpheus::depth_guard_band * p.w() - g.get_depth(p);
+  }
+  return 0.0F;
+}
+
+// clips the convex polygon in to one plane (sutherland-hodgman), returns the number
+// of vertices in out. intersections are computed from the inner vertex of an edge,
+// so that triangles sharing the edge get the same vertex whatever its direction
+auto clip_polygon(unsigned plane, const GuardBand& g, const Vector4* in, int n, Vector4* out) -> int {
+  int m = 0;
+  for (int i = 0; i < n; ++i) {
+    const Vector4& p = in[i];
+    const Vector4& q = in[(i + 1) % n];
+    float dp = distance(plane, p, g);
+    float dq = distance(plane, q, g);
+    if (dp >= 0.0F) out[m++] = p;
+    if (dp >= 0.0F && dq < 0.0F) {
+      out[m++] = p + (q - p) * (dp / (dp - dq));
+    } else if (dp < 0.0F && dq >= 0.0F) {
+      out[m++] = q + (p - q) * (dq / (dq - dp));
+    }
+  }
+  return m;
+}
+
+}  // namespace
+
+auto morpheus::classify_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, int width, int height,
+                                 DepthRange range, ClipStats* stats) -> ClipResult {
+  GuardBand g(width, height, range);
+  unsigned c0 = get_outcode(v0, g);
+  unsigned c1 = get_outcode(v1, g);
+  unsigned c2 = get_outcode(v2, g);
+
+  ClipResult result = ClipResult::unclipped;
+  if ((c0 & c1 & c2 & view_planes) != 0) {
+    result = ClipResult::culled;
+  } else if (((c0 | c1 | c2) & clip_planes) != 0) {
+    result = ClipResult::clipped;
+  }
+
+  if (stats != nullptr) {
+    ++stats->triangles;
+    if (result == ClipResult::culled) ++stats->culled;
+    if (result == ClipResult::clipped) ++stats->clipped;
+  }
+  return result;
+}
+
+auto morpheus::clip_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, int width, int height,
+                             DepthRange range, Vector4* out) -> std::size_t {
+  GuardBand g(width, height, range);
+  unsigned crossed = (get_outcode(v0, g) | get_outcode(v1, g) | get_outcode(v2, g)) & clip_planes;
+
+  Vector4 polygon[2][max_vertices] = {{v0, v1, v2}};
+  int n = 3;
+  int current = 0;
+  for (unsigned plane : clip_plane_list) {
+    if ((crossed & plane) == 0) continue;
+    n = clip_polygon(plane, g, polygon[current], n, polygon[1 - current]);
+    current = 1 - current;
+    if (n < 3) return 0;
+  }
+
+  // fan around the first vertex
+  const Vector4* p = polygon[current];
+  for (int i = 1; i + 1 < n; ++i) {
+    out[3 * (i - 1)] = p[0];
+    out[3 * (i - 1) + 1] = p[i];
+    out[3 * (i - 1) + 2] = p[i + 1];
+  }
+  return static_cast<std::size_t>(n - 2);
+}
@@ -0,0 +1,61 @@
+#ifndef MORPHEUS_CLIPPER_HPP
+#define MORPHEUS_CLIPPER_HPP
+
+#include <cstddef>
+
+#include <math/Projection.hpp>
+#include <math/Vector4.hpp>
+
+namespace morpheus {
+
+// guard-band clipping of clip-space triangles, with depth in [0, w] as the
+// projections of Projection.hpp produce it: the near plane is z = 0 and the far
+// plane z = w, or the other way around for DepthRange::reversed.
+// a triangle in front of the near plane whose window coordinates are all within
+// +-guard_band pixels goes to the rasterizer as it is: its setup is exact in 24.8
+// and its bounding box scissors it to the target. only triangles that cross the
+// near plane or leave the guard band are clipped, and only against the planes they
+// cross, which leaves most triangles with a vertex off screen unclipped. triangles
+// entirely outside one plane of the view volume are culled. the far plane is left
+// to the depth test, but triangles reaching past depth_guard_band are clipped there
+// so that their depth stays in the range of to_window
+
+// half the extent of the guard band in pixels, targets must be smaller
+const float guard_band = 16384.0F;
+
+// depth (z / w) of the far side of the guard band, far beyond the far plane at 1 and
+// half the depth to_window can convert. 1 - depth_guard_band with reversed depth
+const float depth_guard_band = 64.0F;
+
+// at most that many triangles come out of clipping one against the near plane and
+// the five sides of the guard band
+const std::size_t max_clipped_triangles = 7;
+
+// where a triangle goes
+enum class ClipResult { culled, unclipped, clipped };
+
+// where the triangles of classify_triangle calls went
+struct ClipStats {
+  std::size_t triangles{0};
+  // entirely outside a plane of the view volume
+  std::size_t culled{0};
+  // went through the clipper
+  std::size_t clipped{0};
+};
+
+// tests the triangle v0 v1 v2 for a width x height target with the given depth
+// range against the view volume and the guard band, and counts it in stats unless
+// null
+auto classify_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, int width, int height,
+                       DepthRange range, ClipStats* stats = nullptr) -> ClipResult;
+
+// the parts of a triangle classified as clipped that are in front of the near plane
+// and inside the guard band, as consecutive vertex triples in out, which must hold
+// 3 * max_clipped_triangles vertices. returns the number of triangles, 0 if it is
+// clipped away
+auto clip_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, int width, int height, DepthRange range,
+                   Vector4* out) -> std::size_t;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_CLIPPER_HPP
@@ -0,0 +1,20 @@
+#include "Framebuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+morpheus::Framebuffer::Framebuffer(int width, int height, DepthRange depth_range)
+    : width_(width), height_(height), stride_((static_cast<std::size_t>(width) + 7) & ~std::size_t(7)),
+      depth_range_(depth_range) {
+  assert(width > 0 && height > 0);
+  std::size_t rows = (static_cast<std::size_t>(height) + 1) & ~std::size_t(1);
+  color_.resize(rows * stride_, 0);
+  depth_.resize(rows * stride_, get_far_depth());
+}
+
+void morpheus::Framebuffer::clear(std::uint32_t color, float depth) {
+  std::fill(color_.begin(), color_.end(), color);
+  std::fill(depth_.begin(), depth_.end(), depth);
+}
@@ -0,0 +1,57 @@
+#ifndef MORPHEUS_FRAMEBUFFER_HPP
+#define MORPHEUS_FRAMEBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <math/Projection.hpp>
+
+namespace morpheus {
+
+// color and depth targets of the rasterizer, row-major with the origin at the top
+// left. rows are padded to a multiple of 8 pixels and the row count to a multiple
+// of 2, so that the raster kernels can always load and store whole 4x2 blocks.
+// colors are 32-bit values written as given, depth is in [0, 1] and a pixel is
+// written when its depth is nearer than the stored one: less with
+// DepthRange::standard, greater with DepthRange::reversed
+class Framebuffer {
+ private:
+  int width_;
+  int height_;
+  std::size_t stride_;
+  DepthRange depth_range_;
+  std::vector<std::uint32_t> color_;
+  std::vector<float> depth_;
+
+ public:
+  // cleared to color 0 and the far depth
+  Framebuffer(int width, int height, DepthRange depth_range = DepthRange::standard);
+
+  auto get_width() const -> int { return width_; }
+  auto get_height() const -> int { return height_; }
+
+  auto get_depth_range() const -> DepthRange { return depth_range_; }
+
+  // 1 for DepthRange::standard, 0 for reversed
+  auto get_far_depth() const -> float { return depth_range_ == DepthRange::reversed ? 0.0F : 1.0F; }
+
+  // in pixels, between the starts of consecutive rows
+  auto get_stride() const -> std::size_t { return stride_; }
+
+  // padding included, to the far depth unless given
+  void clear(std::uint32_t color) { clear(color, get_far_depth()); }
+  void clear(std::uint32_t color, float depth);
+
+  auto get_color(int x, int y) const -> std::uint32_t { return color_[y * stride_ + x]; }
+  auto get_depth(int x, int y) const -> float { return depth_[y * stride_ + x]; }
+
+  auto color_data() -> std::uint32_t* { return color_.data(); }
+  auto color_data() const -> const std::uint32_t* { return color_.data(); }
+  auto depth_data() -> float* { return depth_.data(); }
+  auto depth_data() const -> const float* { return depth_.data(); }
+};
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_FRAMEBUFFER_HPP
@@ -0,0 +1,337 @@
+#include "RasterKernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <math/Simd.hpp>
+
+// compiled once per instruction set level with -march set accordingly (see
+// add_kernel_objects in src/CMakeLists.txt), MORPHEUS_KERNEL_LEVEL names the
+// namespace of the table. like the batch kernels, nothing here may call inline
+// functions of the library headers
+
+#if !defined(MORPHEUS_KERNEL_LEVEL)
+#define MORPHEUS_KERNEL_LEVEL scalar
+#endif
+
+namespace {
+
+using morpheus::TriangleSetup;
+
+// a rectangle of the bounding box of t, with the edge values at its first pixel. x0
+// is a multiple of 4 and y0 of 2 like TriangleSetup::x0, y0
+struct Rect {
+  std::int32_t x0, y0;
+  std::int32_t x1, y1;
+  std::int64_t e[3];
+};
+
+// not std::min and max, whose out-of-line copies (in debug builds) could come from
+// the object of another level
+inline auto min(std::int64_t a, std::int64_t b) -> std::int64_t { return a < b ? a : b; }
+inline auto max(std::int64_t a, std::int64_t b) -> std::int64_t { return a < b ? b : a; }
+
+// blocks of the coarse pass, a multiple of the 4x2 blocks of the simd kernels
+const std::int32_t coarse_size = 8;
+
+// calls scan(r, edges) for the parts of the bounding box of t that may be covered.
+// bounding boxes of at least two coarse blocks in some direction are split into
+// blocks, each classified by the extremes of the edge functions over its pixel
+// centers, which are at its corners: blocks outside an edge are skipped, blocks
+// inside all of them scanned without edge tests (edges is std::false_type) and the
+// rest with per-pixel tests (std::true_type). smaller boxes are scanned directly
+template <typename F>
+void traverse(const TriangleSetup& t, F scan) {
+  if (t.x1 - t.x0 < 2 * coarse_size && t.y1 - t.y0 < 2 * coarse_size) {
+    scan(Rect{t.x0, t.y0, t.x1, t.y1, {t.e[0], t.e[1], t.e[2]}}, std::true_type{});
+    return;
+  }
+
+  for (std::int32_t y = t.y0; y <= t.y1; y += coarse_size) {
+    for (std::int32_t x = t.x0; x <= t.x1; x += coarse_size) {
+      Rect r{x, y, static_cast<std::int32_t>(min(x + coarse_size - 1, t.x1)),
+             static_cast<std::int32_t>(min(y + coarse_size - 1, t.y1)), {}};
+      std::int64_t dx = x - t.x0;
+      std::int64_t dy = y - t.y0;
+      std::int64_t w = r.x1 - x;
+      std::int64_t h = r.y1 - y;
+
+      bool inside = true;
+      bool outside = false;
+      for (int k = 0; k < 3; ++k) {
+        std::int64_t a = t.a[k];
+        std::int64_t b = t.b[k];
+        r.e[k] = t.e[k] + a * dx + b * dy;
+        std::int64_t low = r.e[k] + min(a * w, 0) + min(b * h, 0);
+        std::int64_t high = r.e[k] + max(a * w, 0) + max(b * h, 0);
+        inside = inside && low >= 0;
+        outside = outside || high < 0;
+      }
+      if (outside) continue;
+
+      if (inside) {
+        scan(r, std::false_type{});
+      } else {
+        scan(r, std::true_type{});
+      }
+    }
+  }
+}
+
+// the depth test, z nearer than old: greater with reversed depth, less otherwise.
+// for vectors the result is a lane mask
+template <bool Greater, typename T>
+inline auto nearer(const T& z, const T& old) -> decltype(z < old) {
+  if constexpr (Greater) {
+    return z > old;
+  } else {
+    return z < old;
+  }
+}
+
+#if defined(MORPHEUS_SSE)
+// pixels are visited in blocks of two rows, one register per block: 4x2 pixels,
+// two 2x2 quads side by side, from avx on, and a single 2x2 quad with sse. lanes
+// [0, width) are on the first row and [width, 2 * width) on the second. edge values
+// are 32-bit lanes for narrow triangles, 64-bit lanes otherwise
+#if defined(MORPHEUS_AVX)
+struct Lanes {
+  static const int width = 4;
+
+  typedef std::int32_t int32_type __attribute__((vector_size(32)));
+  typedef std::uint32_t uint32_type __attribute__((vector_size(32)));
+  typedef std::int64_t int64_type __attribute__((vector_size(64)));
+  typedef float float_type __attribute__((vector_size(32)));
+
+  // one row of a block, loaded and stored on its own as the rows are stride apart
+  typedef float float_row __attribute__((vector_size(16), aligned(4)));
+  typedef std::uint32_t uint32_row __attribute__((vector_size(16), aligned(4)));
+
+  // x and y of each lane relative to the top-left pixel of the block
+  static auto get_dx() -> int32_type { return int32_type{0, 1, 2, 3, 0, 1, 2, 3}; }
+  static auto get_dy() -> int32_type { return int32_type{0, 0, 0, 0, 1, 1, 1, 1}; }
+
+  static auto any(const int32_type& m) -> bool {
+    __m256i v;
+    std::memcpy(&v, &m, sizeof(v));
+    return _mm256_testz_si256(v, v) == 0;
+  }
+
+  static auto join(const float_row& a, const float_row& b) -> float_type {
+    return __builtin_shufflevector(a, b, 0, 1, 2, 3, 4, 5, 6, 7);
+  }
+
+  static auto join(const uint32_row& a, const uint32_row& b) -> uint32_type {
+    return __builtin_shufflevector(a, b, 0, 1, 2, 3, 4, 5, 6, 7);
+  }
+};
+#else
+struct Lanes {
+  static const int width = 2;
+
+  typedef std::int32_t int32_type __attribute__((vector_size(16)));
+  typedef std::uint32_t uint32_type __attribute__((vector_size(16)));
+  typedef std::int64_t int64_type __attribute__((vector_size(32)));
+  typedef float float_type __attribute__((vector_size(16)));
+
+  typedef float float_row __attribute__((vector_size(8), aligned(4)));
+  typedef std::uint32_t uint32_row __attribute__((vector_size(8), aligned(4)));
+
+  static auto get_dx() -> int32_type { return int32_type{0, 1, 0, 1}; }
+  static auto get_dy() -> int32_type { return int32_type{0, 0, 1, 1}; }
+
+  static auto any(const int32_type& m) -> bool {
+    __m128i v;
+    std::memcpy(&v, &m, sizeof(v));
+    return _mm_movemask_epi8(v) != 0;
+  }
+
+  static auto join(const float_row& a, const float_row& b) -> float_type {
+    return __builtin_shufflevector(a, b, 0, 1, 2, 3);
+  }
+
+  static auto join(const uint32_row& a, const uint32_row& b) -> uint32_type {
+    return __builtin_shufflevector(a, b, 0, 1, 2, 3);
+  }
+};
+#endif
+
+using int32_type = Lanes::int32_type;
+using uint32_type = Lanes::uint32_type;
+using float_type = Lanes::float_type;
+
+// each row is loaded on its own and the rows are joined in registers, a block
+// assembled in memory would stall on store forwarding
+template <typename V, typename Row, typename T>
+inline void load_block(const T* p, std::size_t stride, V& v) {
+  Row a, b;
+  std::memcpy(&a, p, sizeof(a));
+  std::memcpy(&b, p + stride, sizeof(b));
+  v = Lanes::join(a, b);
+}
+
+template <typename V, typename T>
+inline void store_block(T* p, std::size_t stride, const V& v) {
+  std::memcpy(p, &v, Lanes::width * sizeof(T));
+  std::memcpy(p + stride, reinterpret_cast<const char*>(&v) + Lanes::width * sizeof(T), Lanes::width * sizeof(T));
+}
+
+// covered holds the covered pixels of the block at offset. vectors are passed by
+// reference, their by-value abi differs between levels
+template <bool Greater>
+inline void shade_block(const TriangleSetup& t, const float_type& z, const int32_type& covered, std::uint32_t* color,
+                        float* depth, std::size_t stride, std::size_t offset) {
+  float_type old_depth;
+  load_block<float_type, Lanes::float_row>(depth + offset, stride, old_depth);
+  int32_type m = covered & nearer<Greater>(z, old_depth);
+  if (!Lanes::any(m)) return;
+
+  float_type new_depth = m ? z : old_depth;
+  store_block(depth + offset, stride, new_depth);
+
+  uint32_type old_color;
+  load_block<uint32_type, Lanes::uint32_row>(color + offset, stride, old_color);
+  uint32_type new_color = m ? uint32_type{} + t.color : old_color;
+  store_block(color + offset, stride, new_color);
+}
+
+// coverage of a block from the or of its three edge values, set where all of them
+// are >= 0. 64-bit lanes are narrowed to their upper halves, which keep the sign
+inline auto covered(const int32_type& e) -> int32_type { return e >= 0; }
+
+inline auto covered(const Lanes::int64_type& e) -> int32_type {
+  return __builtin_convertvector(e >> 32, int32_type) >= 0;
+}
+
+// V is Lanes::int32_type for narrow triangles and Lanes::int64_type otherwise.
+// without Edges every pixel of r is known to be covered and only the depth test
+// is left
+template <typename V, typename S, bool Edges, bool Greater>
+void scan_rect(const TriangleSetup& t, const Rect& r, std::uint32_t* color, float* depth, std::size_t stride) {
+  const int width = Lanes::width;
+  int32_type block_dx = Lanes::get_dx();
+  int32_type block_dy = Lanes::get_dy();
+
+  // edge values at the first block of the current row, and their steps to the next
+  // block in x and to the next row of blocks. zero and unused without Edges
+  V row[3] = {}, step_x[3] = {}, step_y[3] = {};
+  if constexpr (Edges) {
+    V dx = __builtin_convertvector(block_dx, V);
+    V dy = __builtin_convertvector(block_dy, V);
+    for (int k = 0; k < 3; ++k) {
+      row[k] = static_cast<S>(r.e[k]) + static_cast<S>(t.a[k]) * dx + static_cast<S>(t.b[k]) * dy;
+      step_x[k] = V{} + static_cast<S>(t.a[k]) * width;
+      step_y[k] = V{} + static_cast<S>(t.b[k]) * 2;
+    }
+  }
+
+  for (std::int32_t y = r.y0; y <= r.y1; y += 2) {
+    V e0 = row[0];
+    V e1 = row[1];
+    V e2 = row[2];
+    // depth from the offsets to the origin of the plane, see TriangleSetup::zx
+    float_type z_row = t.z + t.dzdy * __builtin_convertvector(block_dy + (y - t.zy), float_type);
+    // the second row of the last block row may be past the rectangle
+    int32_type rows = y < r.y1 ? int32_type{} - 1 : block_dy == 0;
+
+    for (std::int32_t x = r.x0; x <= r.x1; x += width) {
+      int32_type m = rows;
+      if constexpr (Edges) m &= covered(e0 | e1 | e2);
+      if (x + width - 1 > r.x1) m &= block_dx <= r.x1 - x;
+      if (!Edges || Lanes::any(m)) {
+        float_type z = z_row + t.dzdx * __builtin_convertvector(block_dx + (x - t.zx), float_type);
+        shade_block<Greater>(t, z, m, color, depth, stride, y * stride + x);
+      }
+
+      if constexpr (Edges) {
+        e0 += step_x[0];
+        e1 += step_x[1];
+        e2 += step_x[2];
+      }
+    }
+
+    if constexpr (Edges) {
+      for (int k = 0; k < 3; ++k) row[k] += step_y[k];
+    }
+  }
+}
+
+template <bool Greater>
+void rasterize(const TriangleSetup* triangles, std::size_t count, std::uint32_t* color, float* depth,
+               std::size_t stride) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const TriangleSetup& t = triangles[i];
+    if (t.narrow) {
+      traverse(t, [&](const Rect& r, auto edges) {
+        scan_rect<Lanes::int32_type, std::int32_t, decltype(edges)::value, Greater>(t, r, color, depth, stride);
+      });
+    } else {
+      traverse(t, [&](const Rect& r, auto edges) {
+        scan_rect<Lanes::int64_type, std::int64_t, decltype(edges)::value, Greater>(t, r, color, depth, stride);
+      });
+    }
+  }
+}
+#else
+// one pixel at a time, with 64-bit edge values
+template <bool Edges, bool Greater>
+void scan_rect(const TriangleSetup& t, const Rect& r, std::uint32_t* color, float* depth, std::size_t stride) {
+  std::int64_t row[3] = {r.e[0], r.e[1], r.e[2]};
+
+  for (std::int32_t y = r.y0; y <= r.y1; ++y) {
+    std::int64_t e[3] = {row[0], row[1], row[2]};
+    // depth from the offsets to the origin of the plane, see TriangleSetup::zx
+    float z_row = t.z + t.dzdy * static_cast<float>(y - t.zy);
+
+    for (std::int32_t x = r.x0; x <= r.x1; ++x) {
+      std::size_t offset = y * stride + x;
+      if (!Edges || (e[0] | e[1] | e[2]) >= 0) {
+        float z = z_row + t.dzdx * static_cast<float>(x - t.zx);
+        if (nearer<Greater>(z, depth[offset])) {
+          depth[offset] = z;
+          color[offset] = t.color;
+        }
+      }
+      for (int k = 0; k < 3; ++k) e[k] += t.a[k];
+    }
+
+    for (int k = 0; k < 3; ++k) row[k] += t.b[k];
+  }
+}
+
+template <bool Greater>
+void rasterize(const TriangleSetup* triangles, std::size_t count, std::uint32_t* color, float* depth,
+               std::size_t stride) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const TriangleSetup& t = triangles[i];
+    traverse(t, [&](const Rect& r, auto edges) {
+      scan_rect<decltype(edges)::value, Greater>(t, r, color, depth, stride);
+    });
+  }
+}
+#endif
+
+void rasterize(const TriangleSetup* triangles, std::size_t count, std::uint32_t* color, float* depth,
+               std::size_t stride, bool greater) {
+  if (greater) {
+    rasterize<true>(triangles, count, color, depth, stride);
+  } else {
+    rasterize<false>(triangles, count, color, depth, stride);
+  }
+}
+
+}  // namespace
+
+namespace morpheus {
+namespace MORPHEUS_KERNEL_LEVEL {
+
+auto get_raster_kernels() -> RasterKernels {
+  RasterKernels kernels;
+  kernels.rasterize = rasterize;
+  return kernels;
+}
+
+}  // namespace MORPHEUS_KERNEL_LEVEL
+}  // namespace morpheus
@@ -0,0 +1,59 @@
+#ifndef MORPHEUS_RASTER_KERNELS_HPP
+#define MORPHEUS_RASTER_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// table of the kernels behind rasterize and draw_triangles (see Rasterizer.hpp).
+// RasterKernels.cpp is compiled once per instruction set level like the batch
+// kernels of the math library and picked with the same level (see
+// math/Dispatch.hpp).
+// kernels take plain integers and floats so that they don't depend on the library
+// headers
+
+namespace morpheus {
+
+// triangle in the form the kernels scan it, made by setup_triangle. larger
+// bounding boxes are first classified in 8x8 blocks (skipped, filled without edge
+// tests or tested per pixel), pixels are visited in blocks of up to 4x2, two 2x2
+// quads side by side, starting at x0, y0.
+// e holds the three edge functions at the center of pixel x0, y0, reduced so that
+// a pixel is covered when all of them are >= 0 with the top-left fill rule already
+// applied, and a, b are their steps per pixel in x and y. if narrow is set every
+// edge value the kernels compute fits in 32 bits
+struct TriangleSetup {
+  // first block, x0 a multiple of 4 and y0 of 2, and the last pixel of the
+  // bounding box inside the target
+  std::int32_t x0, y0;
+  std::int32_t x1, y1;
+
+  std::int64_t e[3];
+  std::int32_t a[3];
+  std::int32_t b[3];
+  bool narrow;
+
+  // depth at the center of pixel zx, zy (x0, y0 before any scissor_triangle) and
+  // its steps per pixel. the kernels compute the depth of each pixel from its
+  // offsets to zx, zy rather than by stepping, so it rounds the same however the
+  // triangle is walked or split into tiles
+  std::int32_t zx, zy;
+  float z, dzdx, dzdy;
+
+  std::uint32_t color;
+};
+
+struct RasterKernels {
+  // rasterizes count triangles in order, with a less depth test or a greater one if
+  // greater is set, into targets of stride pixels per row padded like Framebuffer
+  void (*rasterize)(const TriangleSetup* triangles, std::size_t count, std::uint32_t* color, float* depth,
+                    std::size_t stride, bool greater);
+};
+
+namespace scalar { auto get_raster_kernels() -> RasterKernels; }
+namespace sse4_2 { auto get_raster_kernels() -> RasterKernels; }
+namespace avx2 { auto get_raster_kernels() -> RasterKernels; }
+namespace avx512 { auto get_raster_kernels() -> RasterKernels; }
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_RASTER_KERNELS_HPP
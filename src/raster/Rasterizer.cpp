@@ -0,0 +1,207 @@
+#include "Rasterizer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <math/Dispatch.hpp>
+#include <math/Projection.hpp>
+#include <math/Span.hpp>
+#include <math/Vector4.hpp>
+#include <math/VectorFixed.hpp>
+
+#include "Clipper.hpp"
+#include "Framebuffer.hpp"
+#include "RasterKernels.hpp"
+
+namespace {
+
+using morpheus::RasterKernels;
+
+const int level_count = 4;
+
+const int subpixel_bits = 8;
+const std::int32_t subpixels = 256;
+const std::int32_t half_pixel = 128;
+
+// triangles set up before calling the kernels
+const std::size_t setup_batch = 64;
+
+// MORPHEUS_DISPATCH is defined when RasterKernels.cpp is compiled for every level
+auto get_tables() -> const RasterKernels* {
+  static const RasterKernels tables[level_count] = {
+    morpheus::scalar::get_raster_kernels(),
+#if defined(MORPHEUS_DISPATCH)
+    morpheus::sse4_2::get_raster_kernels(),
+    morpheus::avx2::get_raster_kernels(),
+    morpheus::avx512::get_raster_kernels(),
+#endif
+  };
+  return tables;
+}
+
+// floor(v / 256), gcc and clang shift signed values arithmetically
+auto to_pixels(std::int64_t v) -> std::int64_t { return v >> subpixel_bits; }
+
+auto fits(std::int64_t v) -> bool {
+  return v >= std::numeric_limits<std::int32_t>::min() && v <= std::numeric_limits<std::int32_t>::max();
+}
+
+}  // namespace
+
+auto morpheus::setup_triangle(const Vector3fx& v0, const Vector3fx& v1, const Vector3fx& v2, std::uint32_t color,
+                              int width, int height, TriangleSetup& out) -> bool {
+  Vector2i p[3] = {to_subpixel(v0), to_subpixel(v1), to_subpixel(v2)};
+  float z[3] = {static_cast<float>(v0.z()), static_cast<float>(v1.z()), static_cast<float>(v2.z())};
+
+  std::int64_t area;
+  if (!checked_area(p[0], p[1], p[2], area) || area == 0) return false;
+  if (area < 0) {
+    std::swap(p[1], p[2]);
+    std::swap(z[1], z[2]);
+  }
+
+  // pixels whose centers are inside the bounding box, clipped to the target
+  std::int64_t min_x = std::min({p[0].x(), p[1].x(), p[2].x()});
+  std::int64_t max_x = std::max({p[0].x(), p[1].x(), p[2].x()});
+  std::int64_t min_y = std::min({p[0].y(), p[1].y(), p[2].y()});
+  std::int64_t max_y = std::max({p[0].y(), p[1].y(), p[2].y()});
+  std::int64_t x0 = std::max<std::int64_t>(-to_pixels(half_pixel - min_x), 0);
+  std::int64_t x1 = std::min<std::int64_t>(to_pixels(max_x - half_pixel), width - 1);
+  std::int64_t y0 = std::max<std::int64_t>(-to_pixels(half_pixel - min_y), 0);
+  std::int64_t y1 = std::min<std::int64_t>(to_pixels(max_y - half_pixel), height - 1);
+  if (x0 > x1 || y0 > y1) return false;
+
+  out.x0 = static_cast<std::int32_t>(x0 & ~std::int64_t(3));
+  out.y0 = static_cast<std::int32_t>(y0 & ~std::int64_t(1));
+  out.x1 = static_cast<std::int32_t>(x1);
+  out.y1 = static_cast<std::int32_t>(y1);
+
+  // the kernels step one block and one row of blocks past the bounding box
+  std::int64_t last_x = ((out.x1 - out.x0) / 4 + 1) * 4 + 3;
+  std::int64_t last_y = ((out.y1 - out.y0) / 2 + 1) * 2 + 1;
+
+  Vector2i origin(out.x0 * subpixels + half_pixel, out.y0 * subpixels + half_pixel);
+  out.narrow = true;
+  for (int k = 0; k < 3; ++k) {
+    EdgeFunction f;
+    std::int64_t e;
+    if (!make_edge_function(p[k], p[(k + 1) % 3], f) || !f.evaluate(origin, e)) return false;
+
+    // pixels exactly on an edge are covered only for top and left edges. the edge
+    // value changes by a multiple of 256 from pixel center to pixel center, so the
+    // sign of the rest of the division doesn't matter
+    bool top_left = f.a > 0 || (f.a == 0 && f.b > 0);
+    e = to_pixels(e - (top_left ? 0 : 1));
+
+    out.e[k] = e;
+    out.a[k] = f.a;
+    out.b[k] = f.b;
+    // extremes of a linear function are at the corners
+    out.narrow = out.narrow && fits(e) && fits(e + f.a * last_x) && fits(e + f.b * last_y) &&
+                 fits(e + f.a * last_x + f.b * last_y);
+  }
+
+  // depth plane, in pixels
+  double x[3], y[3];
+  for (int k = 0; k < 3; ++k) {
+    x[k] = static_cast<double>(p[k].x()) / subpixels;
+    y[k] = static_cast<double>(p[k].y()) / subpixels;
+  }
+  double dx1 = x[1] - x[0], dy1 = y[1] - y[0], dz1 = z[1] - z[0];
+  double dx2 = x[2] - x[0], dy2 = y[2] - y[0], dz2 = z[2] - z[0];
+  double det = dx1 * dy2 - dx2 * dy1;
+  double dzdx = (dz1 * dy2 - dz2 * dy1) / det;
+  double dzdy = (dx1 * dz2 - dx2 * dz1) / det;
+
+  // window depth is in [0, 65536), see to_window
+  const double depth_scale = 1.0 / 65536.0;
+  out.zx = out.x0;
+  out.zy = out.y0;
+  out.z = static_cast<float>((z[0] + dzdx * (out.x0 + 0.5 - x[0]) + dzdy * (out.y0 + 0.5 - y[0])) * depth_scale);
+  out.dzdx = static_cast<float>(dzdx * depth_scale);
+  out.dzdy = static_cast<float>(dzdy * depth_scale);
+  out.color = color;
+  return true;
+}
+
+auto morpheus::setup_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, std::uint32_t color,
+                              int width, int height, DepthRange range, TriangleSetup* out, ClipStats* stats)
+    -> std::size_t {
+  // inside the guard band window coordinates are well within the range of to_window
+  float w = static_cast<float>(width);
+  float h = static_cast<float>(height);
+  Vector3fx v[3];
+  switch (classify_triangle(v0, v1, v2, width, height, range, stats)) {
+    case ClipResult::culled: return 0;
+    case ClipResult::unclipped: {
+      bool drawn = to_window(v0, w, h, v[0]) && to_window(v1, w, h, v[1]) && to_window(v2, w, h, v[2]) &&
+                   setup_triangle(v[0], v[1], v[2], color, width, height, out[0]);
+      return drawn ? 1 : 0;
+    }
+    case ClipResult::clipped: break;
+  }
+
+  Vector4 clipped[3 * max_clipped_triangles];
+  std::size_t count = clip_triangle(v0, v1, v2, width, height, range, clipped);
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (to_window(clipped[3 * i], w, h, v[0]) && to_window(clipped[3 * i + 1], w, h, v[1]) &&
+        to_window(clipped[3 * i + 2], w, h, v[2]) && setup_triangle(v[0], v[1], v[2], color, width, height, out[n])) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+auto morpheus::scissor_triangle(const TriangleSetup& t, int x0, int y0, int x1, int y1, TriangleSetup& out) -> bool {
+  assert(x0 % 4 == 0 && y0 % 2 == 0);
+  out = t;
+  out.x0 = std::max(t.x0, x0);
+  out.y0 = std::max(t.y0, y0);
+  out.x1 = std::min(t.x1, x1);
+  out.y1 = std::min(t.y1, y1);
+  if (out.x0 > out.x1 || out.y0 > out.y1) return false;
+
+  // a sub-rectangle of the one setup_triangle checked, narrow still holds. the depth
+  // plane keeps its origin
+  std::int32_t dx = out.x0 - t.x0;
+  std::int32_t dy = out.y0 - t.y0;
+  for (int k = 0; k < 3; ++k) out.e[k] = t.e[k] + std::int64_t(t.a[k]) * dx + std::int64_t(t.b[k]) * dy;
+  return true;
+}
+
+void morpheus::rasterize(span<const TriangleSetup> triangles, Framebuffer& target) {
+  get_raster_kernels().rasterize(triangles.data(), triangles.size(), target.color_data(), target.depth_data(),
+                                 target.get_stride(), target.get_depth_range() == DepthRange::reversed);
+}
+
+auto morpheus::draw_triangles(span<const Vector4> clip, span<const std::uint32_t> colors, Framebuffer& target,
+                              ClipStats* stats) -> std::size_t {
+  assert(clip.size() % 3 == 0 && colors.size() >= clip.size() / 3);
+
+  const RasterKernels& kernels = get_raster_kernels();
+  bool greater = target.get_depth_range() == DepthRange::reversed;
+  // room for the parts of one more clipped triangle
+  TriangleSetup setups[setup_batch + max_clipped_triangles];
+  std::size_t count = 0;
+  std::size_t drawn = 0;
+  for (std::size_t i = 0; i < colors.size() && 3 * i < clip.size(); ++i) {
+    count += setup_triangle(clip[3 * i], clip[3 * i + 1], clip[3 * i + 2], colors[i], target.get_width(),
+                            target.get_height(), target.get_depth_range(), setups + count, stats);
+    if (count >= setup_batch) {
+      kernels.rasterize(setups, count, target.color_data(), target.depth_data(), target.get_stride(), greater);
+      drawn += count;
+      count = 0;
+    }
+  }
+  kernels.rasterize(setups, count, target.color_data(), target.depth_data(), target.get_stride(), greater);
+  return drawn + count;
+}
+
+auto morpheus::get_raster_kernels() -> const RasterKernels& {
+  return get_tables()[static_cast<int>(get_simd_level())];
+}
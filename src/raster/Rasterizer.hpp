@@ -0,0 +1,57 @@
+#ifndef MORPHEUS_RASTERIZER_HPP
+#define MORPHEUS_RASTERIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <math/Projection.hpp>
+#include <math/Span.hpp>
+#include <math/Vector4.hpp>
+#include <math/VectorFixed.hpp>
+
+#include "Clipper.hpp"
+#include "Framebuffer.hpp"
+#include "RasterKernels.hpp"
+
+namespace morpheus {
+
+// half-space rasterization: a pixel is covered when its center is on the inner side
+// of the three edge functions of the triangle (see EdgeFunction), evaluated exactly
+// in integers on the 24.8 subpixel grid. pixels on a shared edge belong to exactly
+// one of the two triangles (top-left fill rule: on a top edge, horizontal with the
+// triangle below it, or a left edge). both windings are drawn, zero area triangles
+// are not
+
+// prepares the triangle v0 v1 v2 in window coordinates (see to_window) for a width x
+// height target. false if nothing of it can be covered on the target, or its edge
+// functions overflow
+auto setup_triangle(const Vector3fx& v0, const Vector3fx& v1, const Vector3fx& v2, std::uint32_t color, int width,
+                    int height, TriangleSetup& out) -> bool;
+
+// same for clip-space positions with the given depth range, culled or clipped where
+// the guard band needs it (see Clipper.hpp). out must hold max_clipped_triangles
+// setups, returns how many it filled. stats may be null
+auto setup_triangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, std::uint32_t color, int width,
+                    int height, DepthRange range, TriangleSetup* out, ClipStats* stats = nullptr) -> std::size_t;
+
+// restricts t to the pixels x0 to x1 and y0 to y1 inclusive, with x0 a multiple of 4
+// and y0 of 2 (e.g. a screen tile). false if that leaves nothing to scan
+auto scissor_triangle(const TriangleSetup& t, int x0, int y0, int x1, int y1, TriangleSetup& out) -> bool;
+
+// with the kernels of the current simd level (see Dispatch.hpp) and the depth test
+// of target
+void rasterize(span<const TriangleSetup> triangles, Framebuffer& target);
+
+// draws the triangles made of consecutive triples of clip-space positions (the
+// outputs of a projection), triangle i with colors[i], on the calling thread (see
+// TiledRasterizer for more). returns the number of triangles that reached the
+// kernels, counting every part of a clipped one. stats may be null
+auto draw_triangles(span<const Vector4> clip, span<const std::uint32_t> colors, Framebuffer& target,
+                    ClipStats* stats = nullptr) -> std::size_t;
+
+// kernels of the current simd level
+auto get_raster_kernels() -> const RasterKernels&;
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_RASTERIZER_HPP
@@ -0,0 +1,161 @@
+#include "TiledRasterizer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <math/Projection.hpp>
+#include <math/Span.hpp>
+#include <math/Vector4.hpp>
+
+#include "Clipper.hpp"
+#include "Framebuffer.hpp"
+#include "RasterKernels.hpp"
+#include "Rasterizer.hpp"
+
+namespace {
+
+// triangles scissored to a tile before calling the kernels
+const std::size_t setup_batch = 64;
+
+}  // namespace
+
+morpheus::TiledRasterizer::TiledRasterizer(int tile_size, int thread_count)
+    : tile_size_(tile_size), thread_count_(thread_count) {
+  assert(tile_size > 0 && tile_size % 4 == 0 && thread_count >= 0);
+  if (thread_count_ == 0) thread_count_ = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  setups_.resize(thread_count_);
+  stats_.resize(thread_count_);
+  for (int i = 1; i < thread_count_; ++i) workers_.emplace_back(&TiledRasterizer::work, this, i);
+}
+
+morpheus::TiledRasterizer::~TiledRasterizer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+void morpheus::TiledRasterizer::run(const std::function<void(int)>& job) {
+  if (workers_.empty()) {
+    job(0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = job;
+    pending_ = static_cast<int>(workers_.size());
+    ++generation_;
+  }
+  start_.notify_all();
+  job(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+void morpheus::TiledRasterizer::work(int thread) {
+  std::uint64_t generation = 0;
+  for (;;) {
+    std::function<void(int)> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+      if (stop_) return;
+      generation = generation_;
+      job = job_;
+    }
+    job(thread);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --pending_;
+    }
+    done_.notify_one();
+  }
+}
+
+auto morpheus::TiledRasterizer::draw_triangles(span<const Vector4> clip, span<const std::uint32_t> colors,
+                                               Framebuffer& target, ClipStats* stats) -> std::size_t {
+  assert(clip.size() % 3 == 0 && colors.size() >= clip.size() / 3);
+
+  int width = target.get_width();
+  int height = target.get_height();
+  int tiles_x = (width + tile_size_ - 1) / tile_size_;
+  int tiles_y = (height + tile_size_ - 1) / tile_size_;
+  std::size_t tile_count = static_cast<std::size_t>(tiles_x) * tiles_y;
+  std::size_t count = std::min(colors.size(), clip.size() / 3);
+
+  bins_.resize(thread_count_ * tile_count);
+  for (std::vector<std::uint32_t>& bin : bins_) bin.clear();
+
+  // front end: setup and binning of a contiguous slice per thread, so that each bin
+  // is in submission order
+  run([&](int thread) {
+    std::size_t begin = count * thread / thread_count_;
+    std::size_t end = count * (thread + 1) / thread_count_;
+    std::vector<std::uint32_t>* bins = &bins_[thread * tile_count];
+    std::vector<TriangleSetup>& setups = setups_[thread];
+    ClipStats& clip_stats = stats_[thread];
+    clip_stats = ClipStats();
+    setups.clear();
+    for (std::size_t i = begin; i < end; ++i) {
+      TriangleSetup parts[max_clipped_triangles];
+      std::size_t n = setup_triangle(clip[3 * i], clip[3 * i + 1], clip[3 * i + 2], colors[i], width, height,
+                                     target.get_depth_range(), parts, &clip_stats);
+      for (std::size_t k = 0; k < n; ++k) {
+        const TriangleSetup& t = parts[k];
+        for (int ty = t.y0 / tile_size_; ty <= t.y1 / tile_size_; ++ty) {
+          for (int tx = t.x0 / tile_size_; tx <= t.x1 / tile_size_; ++tx) {
+            bins[ty * tiles_x + tx].push_back(static_cast<std::uint32_t>(setups.size()));
+          }
+        }
+        setups.push_back(t);
+      }
+    }
+  });
+
+  // back end: whole tiles handed out in order, the bins of all threads in turn
+  const RasterKernels& kernels = get_raster_kernels();
+  bool greater = target.get_depth_range() == DepthRange::reversed;
+  std::atomic<std::size_t> next_tile{0};
+  run([&](int) {
+    TriangleSetup batch[setup_batch];
+    for (std::size_t tile = next_tile++; tile < tile_count; tile = next_tile++) {
+      int x0 = static_cast<int>(tile % tiles_x) * tile_size_;
+      int y0 = static_cast<int>(tile / tiles_x) * tile_size_;
+      int x1 = std::min(x0 + tile_size_, width) - 1;
+      int y1 = std::min(y0 + tile_size_, height) - 1;
+
+      std::size_t n = 0;
+      for (int thread = 0; thread < thread_count_; ++thread) {
+        for (std::uint32_t i : bins_[thread * tile_count + tile]) {
+          if (!scissor_triangle(setups_[thread][i], x0, y0, x1, y1, batch[n])) continue;
+          if (++n == setup_batch) {
+            kernels.rasterize(batch, n, target.color_data(), target.depth_data(), target.get_stride(), greater);
+            n = 0;
+          }
+        }
+      }
+      kernels.rasterize(batch, n, target.color_data(), target.depth_data(), target.get_stride(), greater);
+    }
+  });
+
+  std::size_t drawn = 0;
+  for (int thread = 0; thread < thread_count_; ++thread) {
+    drawn += setups_[thread].size();
+    if (stats != nullptr) {
+      stats->triangles += stats_[thread].triangles;
+      stats->culled += stats_[thread].culled;
+      stats->clipped += stats_[thread].clipped;
+    }
+  }
+  return drawn;
+}
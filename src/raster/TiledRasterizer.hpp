@@ -0,0 +1,73 @@
+#ifndef MORPHEUS_TILED_RASTERIZER_HPP
+#define MORPHEUS_TILED_RASTERIZER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <math/Span.hpp>
+#include <math/Vector4.hpp>
+
+#include "Clipper.hpp"
+#include "Framebuffer.hpp"
+#include "RasterKernels.hpp"
+
+namespace morpheus {
+
+// sort-middle rasterization on a pool of threads. draw_triangles first sets up and
+// clips the triangles in one contiguous slice per thread and bins each setup into
+// the screen tiles its bounding box overlaps, then the threads take whole tiles and
+// rasterize their bins. a tile is only ever written by one thread, so no pixel
+// needs a lock, and the bins of a tile are walked in submission order. depth doesn't
+// depend on the tiles either (see TriangleSetup::zx), so the result matches
+// draw_triangles in Rasterizer.hpp pixel for pixel, depth ties included.
+// the calling thread is one of the threads, a thread count of 1 runs everything on
+// it. not thread safe, one draw at a time
+class TiledRasterizer {
+ private:
+  int tile_size_;
+  int thread_count_;
+
+  // per thread the setups of its slice of the current draw, and per thread and tile
+  // the indices of the setups binned to that tile (thread-major)
+  std::vector<std::vector<TriangleSetup>> setups_;
+  std::vector<std::vector<std::uint32_t>> bins_;
+  std::vector<ClipStats> stats_;
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  std::function<void(int)> job_;
+  std::uint64_t generation_{0};
+  int pending_{0};
+  bool stop_{false};
+
+  // calls job(thread) once on every thread, returns when all calls have returned
+  void run(const std::function<void(int)>& job);
+  void work(int thread);
+
+ public:
+  // tile_size must be a multiple of 4, a thread count of 0 uses one thread per
+  // hardware thread
+  explicit TiledRasterizer(int tile_size = 64, int thread_count = 0);
+  ~TiledRasterizer();
+
+  TiledRasterizer(const TiledRasterizer&) = delete;
+  auto operator=(const TiledRasterizer&) -> TiledRasterizer& = delete;
+
+  auto get_tile_size() const -> int { return tile_size_; }
+  auto get_thread_count() const -> int { return thread_count_; }
+
+  // see draw_triangles in Rasterizer.hpp
+  auto draw_triangles(span<const Vector4> clip, span<const std::uint32_t> colors, Framebuffer& target,
+                      ClipStats* stats = nullptr) -> std::size_t;
+};
+
+}  // namespace morpheus
+
+#endif  // MORPHEUS_TILED_RASTERIZER_HPP
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <geometry/AABB.hpp>
+#include <geometry/Frustum.hpp>
+#include <geometry/Plane.hpp>
+#include <geometry/Ray.hpp>
+#include <geometry/Sphere.hpp>
+#include <geometry/Triangle.hpp>
+#include <math/Dispatch.hpp>
+#include <math/Point3.hpp>
+#include <math/Projection.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector3.hpp>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+auto equal(const morpheus::Vector3& a, const morpheus::Vector3& b) -> bool {
+  return a.x() == b.x() && a.y() == b.y() && a.z() == b.z();
+}
+
+}  // namespace
+
+TEST(GeometryTest, AABB) {
+  morpheus::AABB b(morpheus::Point3(-1.0F, 0.0F, 2.0F), morpheus::Point3(1.0F, 4.0F, 3.0F));
+
+  EXPECT_TRUE(equal(b.get_center(), morpheus::Point3(0.0F, 2.0F, 2.5F)));
+  EXPECT_TRUE(equal(b.get_extent(), morpheus::Vector3(1.0F, 2.0F, 0.5F)));
+  EXPECT_TRUE(contains(b, morpheus::Point3(0.5F, 4.0F, 2.0F)));
+  EXPECT_FALSE(contains(b, morpheus::Point3(0.5F, 4.5F, 2.0F)));
+
+  morpheus::AABB c(morpheus::Point3(0.5F, 3.0F, 3.0F), morpheus::Point3(2.0F, 5.0F, 4.0F));
+  EXPECT_TRUE(intersects(b, c));
+  EXPECT_FALSE(intersects(b, morpheus::AABB(morpheus::Point3(1.5F, 0.0F, 2.0F), morpheus::Point3(2.0F, 1.0F, 3.0F))));
+
+  morpheus::AABB m = merge(b, c);
+  EXPECT_TRUE(equal(m.get_min(), morpheus::Point3(-1.0F, 0.0F, 2.0F)));
+  EXPECT_TRUE(equal(m.get_max(), morpheus::Point3(2.0F, 5.0F, 4.0F)));
+
+  std::vector<morpheus::Point3> points = {{1.0F, -2.0F, 0.0F}, {-3.0F, 1.0F, 0.5F}, {0.0F, 0.0F, -1.0F}};
+  morpheus::AABB p = morpheus::make_aabb(points);
+  EXPECT_TRUE(equal(p.get_min(), morpheus::Point3(-3.0F, -2.0F, -1.0F)));
+  EXPECT_TRUE(equal(p.get_max(), morpheus::Point3(1.0F, 1.0F, 0.5F)));
+
+  // the transformed box is the box around the eight transformed corners
+  morpheus::Transform4 h = {
+    { 0.6F, -0.8F, 0.0F, 1.0F },
+    { 0.8F,  0.6F, 0.0F, 2.0F },
+    { 0.0F,  0.0F, 2.0F, 3.0F }
+  };
+  morpheus::AABB t = h * b;
+  std::vector<morpheus::Point3> corners;
+  for (int i = 0; i < 8; ++i) {
+    morpheus::Point3 corner((i & 1) != 0 ? b.get_max().x() : b.get_min().x(),
+                            (i & 2) != 0 ? b.get_max().y() : b.get_min().y(),
+                            (i & 4) != 0 ? b.get_max().z() : b.get_min().z());
+    corners.push_back(h * corner);
+  }
+  morpheus::AABB r = morpheus::make_aabb(corners);
+
+  float eps = 0.0001F;
+  for (unsigned int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(std::abs(t.get_min()[i] - r.get_min()[i]) < eps);
+    EXPECT_TRUE(std::abs(t.get_max()[i] - r.get_max()[i]) < eps);
+  }
+}
+
+TEST(GeometryTest, Sphere) {
+  morpheus::Sphere s(morpheus::Point3(1.0F, 0.0F, 0.0F), 2.0F);
+  EXPECT_TRUE(contains(s, morpheus::Point3(2.5F, 1.0F, 0.0F)));
+  EXPECT_FALSE(contains(s, morpheus::Point3(3.5F, 0.0F, 0.0F)));
+  EXPECT_TRUE(intersects(s, morpheus::Sphere(morpheus::Point3(4.0F, 0.0F, 0.0F), 1.5F)));
+  EXPECT_FALSE(intersects(s, morpheus::Sphere(morpheus::Point3(4.0F, 0.0F, 0.0F), 0.5F)));
+
+  // the radius follows the largest scale
+  morpheus::Transform4 h(morpheus::Vector3(0.0F, 2.0F, 0.0F), morpheus::Vector3(-1.0F, 0.0F, 0.0F),
+                         morpheus::Vector3(0.0F, 0.0F, 3.0F), morpheus::Point3(0.0F, 0.0F, 1.0F));
+  morpheus::Sphere t = h * s;
+  EXPECT_TRUE(equal(t.get_center(), morpheus::Point3(0.0F, 2.0F, 1.0F)));
+  EXPECT_TRUE(std::abs(t.get_radius() - 6.0F) < 0.0001F);
+
+  // under shear the longest column is shorter than the largest scale, every point
+  // of the sheared sphere stays inside
+  morpheus::Transform4 shear(morpheus::Vector3(1.0F, 0.0F, 0.0F), morpheus::Vector3(1.0F, 1.0F, 0.0F),
+                             morpheus::Vector3(0.0F, 0.0F, 1.0F), morpheus::Point3(0.0F, 0.0F, 0.0F));
+  morpheus::Sphere unit(morpheus::Point3(0.0F, 0.0F, 0.0F), 1.0F);
+  morpheus::Sphere sheared = shear * unit;
+  for (int i = 0; i < 64; ++i) {
+    float a = 0.0981748F * i;
+    morpheus::Point3 p(std::cos(a), std::sin(a), 0.0F);
+    EXPECT_TRUE(contains(sheared, shear * p));
+  }
+}
+
+TEST(GeometryTest, Ray) {
+  morpheus::Ray r(morpheus::Point3(-5.0F, 0.5F, 0.0F), morpheus::Vector3(1.0F, 0.0F, 0.0F));
+  float eps = 0.0001F;
+  float t = -1.0F;
+
+  morpheus::AABB b(morpheus::Point3(-1.0F, -1.0F, -1.0F), morpheus::Point3(1.0F, 1.0F, 1.0F));
+  EXPECT_TRUE(intersect(r, b, 100.0F, t) && std::abs(t - 4.0F) < eps);
+  EXPECT_FALSE(intersect(r, b, 3.0F, t));
+  // parallel to the y and z slabs and outside of the y one
+  EXPECT_FALSE(intersect(morpheus::Ray(morpheus::Point3(-5.0F, 2.0F, 0.0F), r.get_direction()), b, 100.0F, t));
+  // starting inside
+  EXPECT_TRUE(intersect(morpheus::Ray(morpheus::Point3(0.0F, 0.0F, 0.0F), r.get_direction()), b, 100.0F, t) &&
+              t == 0.0F);
+
+  morpheus::Plane f(morpheus::Vector3(-1.0F, 0.0F, 0.0F), morpheus::Point3(2.0F, 0.0F, 0.0F));
+  EXPECT_TRUE(intersect(r, f, 100.0F, t) && std::abs(t - 7.0F) < eps);
+  EXPECT_FALSE(intersect(morpheus::Ray(r.get_origin(), morpheus::Vector3(0.0F, 1.0F, 0.0F)), f, 100.0F, t));
+
+  morpheus::Sphere s(morpheus::Point3(0.0F, 0.0F, 0.0F), 1.0F);
+  EXPECT_TRUE(intersect(r, s, 100.0F, t));
+  morpheus::Point3 p = r.at(t);
+  EXPECT_TRUE(std::abs(dot(p, p) - 1.0F) < eps && p.x() < 0.0F);
+  EXPECT_FALSE(intersect(morpheus::Ray(r.get_origin(), morpheus::Vector3(-1.0F, 0.0F, 0.0F)), s, 100.0F, t));
+}
+
+TEST(GeometryTest, Frustum) {
+  morpheus::Frustum f = morpheus::make_frustum(morpheus::make_perspective(1.0F, 1.5F, 0.5F, 50.0F).get_matrix());
+
+  float eps = 0.0001F;
+  EXPECT_TRUE(std::abs(distance(f.get_plane(4), morpheus::Point3(1.0F, 2.0F, -0.5F))) < eps);
+  // the far plane comes from w - z, which cancels to about 1% of w
+  EXPECT_TRUE(std::abs(distance(f.get_plane(5), morpheus::Point3(-3.0F, 1.0F, -50.0F))) < 0.01F);
+  for (int i = 0; i < morpheus::Frustum::plane_count; ++i) {
+    EXPECT_TRUE(std::abs(dot(f.get_plane(i).get_normal(), f.get_plane(i).get_normal()) - 1.0F) < eps);
+  }
+
+  EXPECT_TRUE(contains(f, morpheus::Point3(0.0F, 0.0F, -10.0F)));
+  EXPECT_FALSE(contains(f, morpheus::Point3(0.0F, 0.0F, 10.0F)));
+  EXPECT_FALSE(contains(f, morpheus::Point3(0.0F, 0.0F, -60.0F)));
+  EXPECT_FALSE(contains(f, morpheus::Point3(20.0F, 0.0F, -10.0F)));
+  EXPECT_TRUE(intersects(f, morpheus::Sphere(morpheus::Point3(0.0F, 0.0F, 1.0F), 2.0F)));
+  EXPECT_FALSE(intersects(f, morpheus::Sphere(morpheus::Point3(0.0F, 0.0F, 2.0F), 1.0F)));
+
+  // a grid of boxes around the frustum, not a multiple of the widest simd width
+  std::vector<morpheus::AABB> boxes;
+  for (int i = 0; i < 293; ++i) {
+    float x = -30.0F + 0.37F * i;
+    float y = std::sin(0.1F * i) * 20.0F;
+    float z = 5.0F - 0.23F * i;
+    float s = 0.5F + 0.01F * (i % 7);
+    boxes.emplace_back(morpheus::Point3(x - s, y - s, z - s), morpheus::Point3(x + s, y + 2.0F * s, z + s));
+  }
+
+  std::vector<bool> expected;
+  std::size_t expected_count = 0;
+  for (const morpheus::AABB& b : boxes) {
+    expected.push_back(intersects(f, b));
+    expected_count += expected.back() ? 1 : 0;
+  }
+  EXPECT_TRUE(expected_count > 0 && expected_count < boxes.size());
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    bool visible[293];
+    EXPECT_TRUE(morpheus::intersects_batch(f, boxes, visible) == expected_count);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), visible));
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(GeometryTest, Triangle) {
+  morpheus::Triangle tri(morpheus::Point3(0.0F, 0.0F, 0.0F), morpheus::Point3(2.0F, 0.0F, 0.0F),
+                         morpheus::Point3(0.0F, 2.0F, 0.0F));
+  float eps = 0.0001F;
+  float t = 0.0F;
+  float u = 0.0F;
+  float v = 0.0F;
+
+  // from above and below, the hit point is a + (b - a) u + (c - a) v
+  morpheus::Ray r(morpheus::Point3(0.5F, 1.0F, 3.0F), morpheus::Vector3(0.0F, 0.0F, -1.5F));
+  EXPECT_TRUE(intersect(r, tri, 100.0F, t, u, v));
+  EXPECT_TRUE(std::abs(t - 2.0F) < eps && std::abs(u - 0.25F) < eps && std::abs(v - 0.5F) < eps);
+  EXPECT_TRUE(intersect(morpheus::Ray(morpheus::Point3(0.5F, 1.0F, -3.0F), morpheus::Vector3(0.0F, 0.0F, 1.0F)), tri,
+                        100.0F, t, u, v));
+  EXPECT_FALSE(intersect(r, tri, 1.5F, t, u, v));
+  EXPECT_FALSE(intersect(morpheus::Ray(morpheus::Point3(1.5F, 1.0F, 3.0F), r.get_direction()), tri, 100.0F, t, u, v));
+  EXPECT_FALSE(intersect(morpheus::Ray(morpheus::Point3(0.5F, 1.0F, 3.0F), morpheus::Vector3(1.0F, 0.0F, 0.0F)), tri,
+                         100.0F, t, u, v));
+
+  // a fan of triangles at growing depths, and rays through parts of it. the
+  // counts are no multiple of the widest simd width
+  std::vector<morpheus::Triangle> triangles;
+  for (int i = 0; i < 101; ++i) {
+    float x = 0.3F * (i % 10);
+    float y = 0.3F * (i / 10);
+    float z = -1.0F - 0.05F * i;
+    triangles.emplace_back(morpheus::Point3(x, y, z), morpheus::Point3(x + 0.5F, y, z + 0.1F),
+                           morpheus::Point3(x, y + 0.5F, z));
+  }
+  morpheus::TriangleStreams streams(triangles);
+  EXPECT_TRUE(streams.size() == triangles.size());
+
+  std::vector<morpheus::Ray> rays;
+  for (int i = 0; i < 29; ++i) {
+    rays.emplace_back(morpheus::Point3(0.1F * i, 0.07F * i, 1.0F), morpheus::Vector3(0.01F * i, 0.02F, -1.0F));
+  }
+
+  // nearest hits of a plain loop over the triangles
+  std::vector<morpheus::RayHit> expected;
+  for (const morpheus::Ray& ray : rays) {
+    morpheus::RayHit hit = {50.0F, 0.0F, 0.0F, morpheus::RayHit::none};
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+      if (intersect(ray, triangles[i], hit.t, t, u, v)) hit = {t, u, v, static_cast<std::uint32_t>(i)};
+    }
+    expected.push_back(hit);
+  }
+  std::size_t expected_count = 0;
+  for (const morpheus::RayHit& hit : expected) expected_count += hit.index != morpheus::RayHit::none ? 1 : 0;
+  EXPECT_TRUE(expected_count > 0 && expected_count < rays.size());
+
+  // binding none to a reference odr-uses it, which links only when it is defined
+  std::vector<std::uint32_t> indices(rays.size(), morpheus::RayHit::none);
+  for (std::size_t i = 0; i < rays.size(); ++i) indices[i] = expected[i].index;
+  EXPECT_TRUE(static_cast<std::size_t>(std::count(indices.begin(), indices.end(), morpheus::RayHit::none)) ==
+              rays.size() - expected_count);
+
+  auto same = [eps](const morpheus::RayHit& a, const morpheus::RayHit& b) {
+    return a.index == b.index && std::abs(a.t - b.t) < eps && std::abs(a.u - b.u) < eps && std::abs(a.v - b.v) < eps;
+  };
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      morpheus::RayHit hit;
+      EXPECT_TRUE(intersect(rays[i], streams, 50.0F, hit) == (expected[i].index != morpheus::RayHit::none));
+      EXPECT_TRUE(same(hit, expected[i]));
+    }
+
+    std::vector<morpheus::RayHit> hits(rays.size());
+    EXPECT_TRUE(intersect(rays, streams, 50.0F, hits) == expected_count);
+    for (std::size_t i = 0; i < rays.size(); ++i) EXPECT_TRUE(same(hits[i], expected[i]));
+  }
+  morpheus::set_simd_level(supported);
+}
@@ -1,11 +1,63 @@
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
+#include <math/CachedTransform.hpp>
+#include <math/Dispatch.hpp>
+#include <math/Fixed.hpp>
+#include <math/Half.hpp>
+#include <math/Matrix.hpp>
 #include <math/Matrix3.hpp>
+#include <math/Matrix4.hpp>
+#include <math/Point3.hpp>
+#include <math/Projection.hpp>
+#include <math/Quaternion.hpp>
+#include <math/RigidTransform.hpp>
+#include <math/Transform4.hpp>
+#include <math/Vector.hpp>
 #include <math/Vector3.hpp>
+#include <math/Vector3A.hpp>
+#include <math/Vector4.hpp>
+#include <math/VectorFixed.hpp>
 
 #include "gtest/gtest.h"
 
+namespace {
+
+// b is not deduced so that it converts to the type of a, e.g. from an expression
+template <typename T>
+struct identity {
+  using type = T;
+};
+
+// elementwise within eps
+template <std::size_t R, std::size_t C>
+auto near(const morpheus::Matrix<float, R, C>& a, const typename identity<morpheus::Matrix<float, R, C>>::type& b,
+          float eps) -> bool {
+  for (std::size_t row = 0; row < R; ++row) {
+    for (std::size_t col = 0; col < C; ++col) {
+      if (std::abs(a(row, col) - b(row, col)) > eps) return false;
+    }
+  }
+  return true;
+}
+
+template <std::size_t N>
+auto near(const morpheus::Vector<float, N>& a, const typename identity<morpheus::Vector<float, N>>::type& b, float eps)
+    -> bool {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (std::abs(a[i] - b[i]) > eps) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 TEST(MathTest, VectorGet) {
     morpheus::Vector3 v1;
 
@@ -201,9 +253,914 @@ TEST(MathTest, MatrixMultiplication) {
 
   morpheus::Vector3 c(n00, n01, n02);
 
-  morpheus::Vector3 v1 = a * c;
+  morpheus::Vector3 v1 = b * c;
 
   EXPECT_TRUE(   abs(v1[0] - 5.0F) < eps 
               && abs(v1[1] - 14.0F) < eps 
               && abs(v1[2] - 23.0F) < eps);
-}
\ No newline at end of file
+}
+
+TEST(MathTest, Vector4Arithmetic) {
+  morpheus::Vector4 a(1.0F, 2.0F, 3.0F, 4.0F);
+  morpheus::Vector4 b(5.0F, 6.0F, 7.0F, 8.0F);
+
+  float eps = 0.001F;
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&a) % 16, 0U);
+
+  morpheus::Vector4 sum = a + b;
+  morpheus::Vector4 difference = b - a;
+  morpheus::Vector4 product = a * 2.0F;
+  morpheus::Vector4 quotient = b / 2.0F;
+
+  EXPECT_TRUE(   abs(sum.x() - 6.0F) < eps && abs(sum.y() - 8.0F) < eps
+              && abs(sum.z() - 10.0F) < eps && abs(sum.w() - 12.0F) < eps);
+  EXPECT_TRUE(   abs(difference.x() - 4.0F) < eps && abs(difference.y() - 4.0F) < eps
+              && abs(difference.z() - 4.0F) < eps && abs(difference.w() - 4.0F) < eps);
+  EXPECT_TRUE(   abs(product.x() - 2.0F) < eps && abs(product.y() - 4.0F) < eps
+              && abs(product.z() - 6.0F) < eps && abs(product.w() - 8.0F) < eps);
+  EXPECT_TRUE(   abs(quotient.x() - 2.5F) < eps && abs(quotient.y() - 3.0F) < eps
+              && abs(quotient.z() - 3.5F) < eps && abs(quotient.w() - 4.0F) < eps);
+
+  EXPECT_TRUE(abs(morpheus::dot(a, b) - 70.0F) < eps);
+  EXPECT_TRUE(abs(morpheus::normalize(a).magnitude() - 1.0F) < eps);
+}
+
+TEST(MathTest, Matrix4Multiplication) {
+  morpheus::Matrix4 a = {
+    {  0.0F,  1.0F,  2.0F,  3.0F },
+    {  4.0F,  5.0F,  6.0F,  7.0F },
+    {  8.0F,  9.0F, 10.0F, 11.0F },
+    { 12.0F, 13.0F, 14.0F, 15.0F }
+  };
+
+  float eps = 0.001F;
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&a) % 16, 0U);
+
+  morpheus::Matrix4 m1 = a * a;
+
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      float expected = 0.0F;
+      for (int k = 0; k < 4; ++k) expected += a(row, k) * a(k, col);
+      EXPECT_TRUE(abs(m1(row, col) - expected) < eps);
+    }
+  }
+
+  a *= a;
+
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) EXPECT_TRUE(abs(a(row, col) - m1(row, col)) < eps);
+  }
+
+  morpheus::Vector4 v(1.0F, 2.0F, 3.0F, 4.0F);
+
+  morpheus::Vector4 v1 = m1 * v;
+
+  for (int row = 0; row < 4; ++row) {
+    float expected = 0.0F;
+    for (int k = 0; k < 4; ++k) expected += m1(row, k) * v[k];
+    EXPECT_TRUE(abs(v1[row] - expected) < eps);
+  }
+}
+
+TEST(MathTest, TransformBatch) {
+  morpheus::Transform4 h = {
+    { 0.0F, -1.0F, 0.0F, 1.0F },
+    { 1.0F,  0.0F, 0.0F, 2.0F },
+    { 0.0F,  0.0F, 2.0F, 3.0F }
+  };
+
+  // not a multiple of the simd width to cover the scalar tail
+  const int count = 19;
+
+  std::vector<morpheus::Point3> points;
+  std::vector<morpheus::Vector3> vectors;
+  std::vector<float> x, y, z;
+  for (int i = 0; i < count; ++i) {
+    points.emplace_back(1.0F * i, 2.0F * i, -1.0F * i);
+    vectors.emplace_back(-1.0F * i, 0.5F * i, 3.0F);
+    x.push_back(1.0F * i);
+    y.push_back(2.0F * i);
+    z.push_back(-1.0F * i);
+  }
+
+  float eps = 0.001F;
+
+  std::vector<morpheus::Point3> transformed_points(count);
+  std::vector<morpheus::Vector3> transformed_vectors(count);
+  morpheus::transform_points(h, points, transformed_points);
+  morpheus::transform_vectors(h, vectors, transformed_vectors);
+
+  for (int i = 0; i < count; ++i) {
+    morpheus::Point3 p = h * points[i];
+    morpheus::Vector3 v = h * vectors[i];
+    EXPECT_TRUE(   abs(transformed_points[i].x() - p.x()) < eps
+                && abs(transformed_points[i].y() - p.y()) < eps
+                && abs(transformed_points[i].z() - p.z()) < eps);
+    EXPECT_TRUE(   abs(transformed_vectors[i].x() - v.x()) < eps
+                && abs(transformed_vectors[i].y() - v.y()) < eps
+                && abs(transformed_vectors[i].z() - v.z()) < eps);
+  }
+
+  // in place on a structure-of-arrays stream
+  morpheus::Stream3<float> stream = { x, y, z };
+  morpheus::transform_points(h, morpheus::Stream3<const float>{ x, y, z }, stream);
+
+  for (int i = 0; i < count; ++i) {
+    EXPECT_TRUE(   abs(x[i] - transformed_points[i].x()) < eps
+                && abs(y[i] - transformed_points[i].y()) < eps
+                && abs(z[i] - transformed_points[i].z()) < eps);
+  }
+}
+
+TEST(MathTest, TransformCompose) {
+  morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, -2.0F, 0.5F));
+  morpheus::Matrix3 r = morpheus::make_rotation_matrix(0.7F, axis);
+  morpheus::Transform4 a(r[0] * 2.0F, r[1], r[2], morpheus::Point3(1.0F, 2.0F, 3.0F));
+  morpheus::Transform4 b = {
+    { 0.0F, -1.0F, 0.0F, 4.0F },
+    { 1.0F,  0.0F, 0.5F, -2.0F },
+    { 0.0F,  0.0F, 3.0F, 1.0F }
+  };
+
+  float eps = 0.001F;
+
+  const morpheus::Matrix4& ma = a;
+  const morpheus::Matrix4& mb = b;
+  morpheus::Matrix4 ab = ma * mb;
+  morpheus::Matrix4 ba = mb * ma;
+
+  morpheus::Transform4 c = a * b;
+  EXPECT_TRUE(near(c, ab, eps) && c(3, 0) == 0.0F && c(3, 1) == 0.0F && c(3, 2) == 0.0F && c(3, 3) == 1.0F);
+
+  // in place on either operand
+  morpheus::Transform4 d = a;
+  morpheus::compose(d, b, d);
+  EXPECT_TRUE(near(d, ab, eps));
+  d = a;
+  morpheus::compose(b, d, d);
+  EXPECT_TRUE(near(d, ba, eps));
+}
+
+TEST(MathTest, RigidTransform) {
+  morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, -2.0F, 0.5F));
+  morpheus::Quaternion q = morpheus::make_rotation_quaternion(0.7F, axis);
+  morpheus::RigidTransform a = morpheus::make_rigid_transform(q, morpheus::Point3(1.0F, 2.0F, 3.0F));
+  morpheus::RigidTransform b(morpheus::make_rotation_matrix_z(-1.2F), morpheus::Point3(-4.0F, 0.5F, 2.0F));
+
+  float eps = 0.001F;
+
+  const morpheus::Transform4& ha = a;
+  const morpheus::Transform4& hb = b;
+
+  // same as the general inverse, and a view matrix undoes its camera
+  morpheus::RigidTransform view = inverse(a);
+  EXPECT_TRUE(near(view.get_transform(), inverse(ha), eps));
+  EXPECT_TRUE(near((view * a).get_transform(), morpheus::RigidTransform().get_transform(), eps));
+
+  morpheus::Point3 p(0.5F, -1.0F, 2.0F);
+  morpheus::Point3 vp = view * (a * p);
+  EXPECT_TRUE(abs(vp.x() - p.x()) < eps && abs(vp.y() - p.y()) < eps && abs(vp.z() - p.z()) < eps);
+
+  // products stay rigid
+  morpheus::RigidTransform ab = a * b;
+  EXPECT_TRUE(near(ab.get_transform(), ha * hb, eps));
+  EXPECT_TRUE(near(inverse(ab).get_transform(), inverse(ha * hb), eps));
+
+  // a scale or a general transform promotes to Transform4
+  morpheus::Transform4 s = scale(a, 2.0F, 1.0F, 0.5F);
+  morpheus::Transform4 hs(morpheus::Vector3(2.0F, 0.0F, 0.0F), morpheus::Vector3(0.0F, 1.0F, 0.0F),
+                          morpheus::Vector3(0.0F, 0.0F, 0.5F), morpheus::Point3(0.0F, 0.0F, 0.0F));
+  static_assert(std::is_same<decltype(a * hs), morpheus::Transform4>::value, "rigid * general is general");
+  EXPECT_TRUE(near(s, a * hs, eps));
+  EXPECT_TRUE(near(inverse(s) * s, morpheus::RigidTransform().get_transform(), eps));
+}
+
+TEST(MathTest, NormalMatrix) {
+  morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, -2.0F, 0.5F));
+  morpheus::Matrix3 r = morpheus::make_rotation_matrix(0.7F, axis);
+  morpheus::Transform4 h(r[0] * 3.0F, r[1], r[2] * 0.5F, morpheus::Point3(1.0F, 2.0F, 3.0F));
+
+  float eps = 0.001F;
+
+  // transformed normals stay perpendicular to transformed tangents
+  morpheus::Vector3 n(0.0F, 0.6F, 0.8F);
+  morpheus::Vector3 t(1.0F, 0.8F, -0.6F);
+  morpheus::Matrix3 m = get_normal_matrix(h);
+  EXPECT_TRUE(abs(dot(m * n, h * t)) < eps);
+
+  morpheus::Transform4 hi = inverse(h);
+  morpheus::Matrix3 expected = {{ hi(0, 0), hi(1, 0), hi(2, 0) },
+                                { hi(0, 1), hi(1, 1), hi(2, 1) },
+                                { hi(0, 2), hi(1, 2), hi(2, 2) }};
+  EXPECT_TRUE(near(m, expected, eps));
+
+  // cached until the 3x3 block is written, translations keep it
+  morpheus::CachedTransform c(h);
+  EXPECT_TRUE(!c.is_rigid() && near(c.get_normal_matrix(), m, eps));
+  c.set_translation(morpheus::Point3(-1.0F, 0.0F, 0.0F));
+  EXPECT_TRUE(near(c.get_normal_matrix(), m, eps));
+  c.set_column(0, r[0]);
+  EXPECT_TRUE(near(c.get_normal_matrix(), get_normal_matrix(c.get_transform()), eps));
+
+  // the rotation of a rigid transform is its own normal matrix
+  c.set_transform(morpheus::RigidTransform(r, morpheus::Point3(1.0F, 2.0F, 3.0F)));
+  EXPECT_TRUE(c.is_rigid() && near(get_normal_matrix(c), r, eps));
+  EXPECT_TRUE(c[0].x() == r(0, 0) && c.is_rigid());
+  c.set_column(3, morpheus::Vector3(0.0F, 0.0F, 1.0F));
+  EXPECT_TRUE(c.is_rigid());
+  EXPECT_TRUE(
+      near(morpheus::CachedTransform().get_normal_matrix(), morpheus::make_scale_matrix(1.0F, 1.0F, 1.0F), eps));
+
+  // singular blocks give the zero matrix, one at a time or batched
+  morpheus::Transform4 flat(r[0], r[1], r[1] * 2.0F, morpheus::Point3(1.0F, 2.0F, 3.0F));
+  morpheus::Matrix3 flat_normals[1];
+  morpheus::get_normal_matrices(morpheus::span<const morpheus::Transform4>(&flat, 1), flat_normals);
+  EXPECT_TRUE(near(get_normal_matrix(flat), morpheus::Matrix3(), eps) &&
+              near(flat_normals[0], morpheus::Matrix3(), eps));
+}
+
+TEST(MathTest, Matrix4Inverse) {
+  morpheus::Matrix4 a = {
+    { 2.0F, 0.0F, 1.0F, 3.0F },
+    { 1.0F, 3.0F, 0.0F, 1.0F },
+    { 0.0F, 1.0F, 4.0F, 2.0F },
+    { 1.0F, 0.0F, 2.0F, 5.0F }
+  };
+
+  float eps = 0.001F;
+
+  // determinant of a computed by cofactor expansion along the first row
+  EXPECT_TRUE(abs(a.determinant() - 68.0F) < eps);
+  EXPECT_TRUE(abs(morpheus::determinant(morpheus::Matrix4()) - 0.0F) < eps);
+
+  morpheus::Matrix4 identity = a * morpheus::inverse(a);
+
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) EXPECT_TRUE(abs(identity(row, col) - (row == col ? 1.0F : 0.0F)) < eps);
+  }
+
+  // enough matrices to cover the 8-wide, 4-wide and scalar paths
+  const int count = 15;
+
+  std::vector<morpheus::Matrix4> matrices;
+  for (int i = 0; i < count; ++i) {
+    morpheus::Matrix4 m = a;
+    m(0, 0) += 0.5F * i;
+    m(2, 3) -= 0.25F * i;
+    matrices.push_back(m);
+  }
+  matrices[5] = morpheus::Matrix4();
+  matrices[13] = morpheus::Matrix4();
+
+  std::vector<morpheus::Matrix4> inverses(count);
+  bool singular[count];
+
+  EXPECT_EQ(morpheus::inverse_batch(matrices, inverses, singular), 2U);
+
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(singular[i], i == 5 || i == 13);
+    morpheus::Matrix4 expected = singular[i] ? morpheus::Matrix4() : morpheus::inverse(matrices[i]);
+    for (int row = 0; row < 4; ++row) {
+      for (int col = 0; col < 4; ++col) EXPECT_TRUE(abs(inverses[i](row, col) - expected(row, col)) < eps);
+    }
+  }
+
+  // singular relative to the size of the columns: nearly dependent columns are,
+  // a tiny but well conditioned scale isn't
+  morpheus::Matrix4 nearly = a;
+  nearly[3] = nearly[2] * 2.0F + morpheus::Vector4(1e-7F, 0.0F, 0.0F, 0.0F);
+  morpheus::Matrix4 tiny;
+  for (int k = 0; k < 4; ++k) tiny(k, k) = 1e-3F;
+  std::vector<morpheus::Matrix4> hard = {nearly, tiny};
+  std::vector<morpheus::Matrix4> hard_inverses(2);
+  bool hard_singular[2];
+  EXPECT_EQ(morpheus::inverse_batch(hard, hard_inverses, hard_singular), 1U);
+  EXPECT_TRUE(hard_singular[0]);
+  EXPECT_FALSE(hard_singular[1]);
+  EXPECT_TRUE(abs(hard_inverses[1](2, 2) * 1e-3F - 1.0F) < eps);
+}
+
+TEST(MathTest, Vector3A) {
+  static_assert(sizeof(morpheus::Vector3A) == 16 && alignof(morpheus::Vector3A) == 16, "padded to a sse register");
+
+  morpheus::Vector3A a(1.0F, -2.0F, 3.0F);
+  morpheus::Vector3A b(0.5F, 4.0F, -1.0F);
+  morpheus::Vector3 va = a;
+  morpheus::Vector3 vb = b;
+
+  float eps = 0.001F;
+
+  // same results as on Vector3, which it binds to without a copy
+  const morpheus::Vector3& r = a;
+  EXPECT_TRUE(r.data() == a.data());
+  EXPECT_TRUE(abs(dot(a, b) - dot(va, vb)) < eps);
+  EXPECT_TRUE(near(cross(a, b), cross(va, vb), eps));
+  EXPECT_TRUE(near(cross(b, a), cross(vb, va), eps));
+
+  morpheus::Vector3A c = a + b * 2.0F;
+  EXPECT_TRUE(near(c, va + vb * 2.0F, eps));
+  c = -a;
+  EXPECT_TRUE(near(c, -va, eps));
+  c += b;
+  EXPECT_TRUE(near(c, vb - va, eps));
+  EXPECT_TRUE(abs(normalize(c).magnitude() - 1.0F) < eps);
+}
+
+TEST(MathTest, VectorExpression) {
+  morpheus::Vector3 a(1.0F, 2.0F, 3.0F);
+  morpheus::Vector3 b(4.0F, 5.0F, 6.0F);
+  morpheus::Point3 p(1.0F, 1.0F, 1.0F);
+  morpheus::Point3 q(2.0F, 3.0F, 4.0F);
+
+  float eps = 0.001F;
+
+  // point + vector is a point, point - point is a vector, scaled points are vectors
+  EXPECT_TRUE((std::is_same<morpheus::expression_result<decltype(p + a * 2.0F)>, morpheus::Point3>::value));
+  EXPECT_TRUE((std::is_same<morpheus::expression_result<decltype(q - p)>, morpheus::Vector3>::value));
+  EXPECT_TRUE((std::is_same<morpheus::expression_result<decltype(p * 2.0F)>, morpheus::Vector3>::value));
+  EXPECT_TRUE((std::is_same<morpheus::expression_result<decltype(a - b)>, morpheus::Vector3>::value));
+  EXPECT_TRUE((morpheus::has_sum_result<morpheus::Point3, morpheus::Vector3>::value));
+  EXPECT_FALSE((morpheus::has_sum_result<morpheus::Point3, morpheus::Point3>::value));
+
+  morpheus::Vector3 v = (a + b) * 2.0F - a / 2.0F;
+
+  EXPECT_TRUE(   abs(v.x() - 9.5F) < eps
+              && abs(v.y() - 13.0F) < eps
+              && abs(v.z() - 16.5F) < eps);
+
+  morpheus::Point3 r = p + (q - p) * 0.5F;
+
+  EXPECT_TRUE(   abs(r.x() - 1.5F) < eps
+              && abs(r.y() - 2.0F) < eps
+              && abs(r.z() - 2.5F) < eps);
+
+  // operands may alias the destination
+  a = b - a;
+
+  EXPECT_TRUE(   abs(a.x() - 3.0F) < eps
+              && abs(a.y() - 3.0F) < eps
+              && abs(a.z() - 3.0F) < eps);
+
+  // expressions yielding points are transformed as points
+  morpheus::Transform4 h = {
+    { 1.0F, 0.0F, 0.0F, 1.0F },
+    { 0.0F, 1.0F, 0.0F, 2.0F },
+    { 0.0F, 0.0F, 1.0F, 3.0F }
+  };
+  morpheus::Point3 hp = h * (p + a);
+  morpheus::Vector3 hv = h * (a + a);
+
+  EXPECT_TRUE(abs(hp.x() - 5.0F) < eps && abs(hp.y() - 6.0F) < eps && abs(hp.z() - 7.0F) < eps);
+  EXPECT_TRUE(abs(hv.x() - 6.0F) < eps && abs(hv.y() - 6.0F) < eps && abs(hv.z() - 6.0F) < eps);
+
+  morpheus::Vector4 c(1.0F, 2.0F, 3.0F, 4.0F);
+  morpheus::Vector4 d = -c + c * 3.0F;
+
+  EXPECT_TRUE(   abs(d.x() - 2.0F) < eps && abs(d.y() - 4.0F) < eps
+              && abs(d.z() - 6.0F) < eps && abs(d.w() - 8.0F) < eps);
+
+  // fused over structure-of-arrays streams
+  std::vector<float> x = { 1.0F, 2.0F, 3.0F, 4.0F, 5.0F };
+  std::vector<float> y = { 5.0F, 4.0F, 3.0F, 2.0F, 1.0F };
+  std::vector<float> z(x.size());
+
+  morpheus::span<const float> xs = x;
+  morpheus::span<const float> ys = y;
+  morpheus::assign(z, xs * 2.0F + ys - xs);
+
+  for (std::size_t i = 0; i < z.size(); ++i) EXPECT_TRUE(abs(z[i] - (x[i] + y[i])) < eps);
+}
+
+TEST(MathTest, GenericVectorMatrix) {
+  // aliases share the generic implementation
+  static_assert(std::is_same<morpheus::Vector4, morpheus::Vector<float, 4>>::value, "");
+  static_assert(std::is_same<morpheus::Matrix3, morpheus::Matrix<float, 3, 3>>::value, "");
+  static_assert(alignof(morpheus::Vector4) == 16 && sizeof(morpheus::Vector3) == 12, "");
+
+  using Vector2d = morpheus::Vector<double, 2>;
+  using Vector3d = morpheus::Vector<double, 3>;
+  using Matrix4d = morpheus::Matrix<double, 4, 4>;
+
+  const double eps = 1e-12;
+
+  Vector2d u(3.0, 4.0);
+  EXPECT_TRUE(std::abs(u.magnitude() - 5.0) < eps);
+
+  Vector3d a(1.0, 2.0, 3.0);
+  Vector3d b(4.0, 5.0, 6.0);
+  Vector3d c = a * 2.0 + b;
+  c -= a;
+  Vector3d n = cross(a, b);
+
+  EXPECT_TRUE(std::abs(c.x() - 5.0) < eps && std::abs(c.y() - 7.0) < eps && std::abs(c.z() - 9.0) < eps);
+  EXPECT_TRUE(std::abs(n.x() + 3.0) < eps && std::abs(n.y() - 6.0) < eps && std::abs(n.z() + 3.0) < eps);
+
+  Matrix4d m = {
+    { 2.0, 0.0, 0.0, 1.0 },
+    { 0.0, 4.0, 0.0, 2.0 },
+    { 0.0, 0.0, 8.0, 3.0 },
+    { 0.0, 0.0, 0.0, 1.0 }
+  };
+
+  EXPECT_TRUE(std::abs(m.determinant() - 64.0) < eps);
+
+  Matrix4d i = m * inverse(m);
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) EXPECT_TRUE(std::abs(i(row, col) - (row == col ? 1.0 : 0.0)) < eps);
+  }
+
+  // rectangular products
+  morpheus::Matrix<double, 2, 3> r = {
+    { 1.0, 2.0, 3.0 },
+    { 4.0, 5.0, 6.0 }
+  };
+  morpheus::Vector<double, 2> ra = r * a;
+
+  EXPECT_TRUE(std::abs(ra.x() - 14.0) < eps && std::abs(ra.y() - 32.0) < eps);
+}
+
+TEST(MathTest, FixedPoint) {
+  using Fixed = morpheus::Fixed<16>;
+  using Vector3x = morpheus::Vector<Fixed, 3>;
+
+  const float eps = 1.0F / Fixed::one;
+
+  Fixed a(1.5F);
+  Fixed b(-2.25F);
+
+  EXPECT_TRUE(abs(static_cast<float>(a * b) + 3.375F) < eps);
+  EXPECT_TRUE(abs(static_cast<float>(b / a) + 1.5F) < eps);
+  EXPECT_TRUE(a + b < Fixed(0) && -b > a);
+
+  Vector3x u(1.0F, 2.0F, 2.0F);
+  Vector3x v(0.5F, 0.5F, 0.5F);
+  Vector3x w = u + v * Fixed(2);
+
+  EXPECT_TRUE(w.x() == Fixed(2) && w.y() == Fixed(3) && w.z() == Fixed(3));
+  EXPECT_TRUE(u.magnitude() == Fixed(3));
+  EXPECT_TRUE(dot(u, v) == Fixed(2.5F));
+
+  morpheus::Matrix<Fixed, 3, 3> m = {
+    { Fixed(2), Fixed(0), Fixed(0) },
+    { Fixed(0), Fixed(4), Fixed(0) },
+    { Fixed(0), Fixed(0), Fixed(1) }
+  };
+  Vector3x mu = inverse(m) * u;
+
+  EXPECT_TRUE(mu.x() == Fixed(0.5F) && mu.y() == Fixed(0.5F) && mu.z() == Fixed(2));
+
+  // products round ties up, quotients and conversions away from zero
+  Fixed half_ulp = Fixed::from_raw(1) * Fixed(0.5F);
+  EXPECT_TRUE(half_ulp.raw() == 1 && (-Fixed::from_raw(1) * Fixed(0.5F)).raw() == 0);
+  EXPECT_TRUE((Fixed::from_raw(-1) / Fixed(2)).raw() == -1 && Fixed(-0.5F / Fixed::one).raw() == -1);
+
+  // conversions out of the 16.16 range are rejected rather than wrapped
+  Fixed c;
+  EXPECT_TRUE(Fixed::checked_convert(-32768.0, c) && c.raw() == std::numeric_limits<std::int32_t>::min());
+  EXPECT_FALSE(Fixed::checked_convert(32768.0, c));
+  EXPECT_FALSE(Fixed::checked_convert(std::nan(""), c));
+
+  // arithmetic wraps, also in constant expressions
+  constexpr Fixed max = Fixed::from_raw(std::numeric_limits<std::int32_t>::max());
+  constexpr Fixed min = Fixed::from_raw(std::numeric_limits<std::int32_t>::min());
+  static_assert(max + Fixed::from_raw(1) == min && min - Fixed::from_raw(1) == max, "sums wrap");
+  static_assert(-min == min, "negation wraps");
+  EXPECT_TRUE((max * Fixed(2)).raw() == -2);
+}
+
+TEST(MathTest, Half) {
+  using morpheus::Half;
+
+  EXPECT_TRUE(Half(1.0F).bits() == 0x3c00 && Half(-2.0F).bits() == 0xc000 && Half(-0.0F).bits() == 0x8000);
+  EXPECT_TRUE(Half(65504.0F).bits() == 0x7bff && Half(-1e6F).bits() == 0xfc00);
+  EXPECT_TRUE(static_cast<float>(Half::from_bits(0x0001)) == 5.9604645e-08F);
+
+  // round to nearest even, also across the normal range and into infinity
+  EXPECT_TRUE(Half(1.0F + 1.0F / 2048.0F).bits() == 0x3c00);
+  EXPECT_TRUE(Half(1.0F + 3.0F / 2048.0F).bits() == 0x3c02);
+  EXPECT_TRUE(Half(2.9802322e-08F).bits() == 0x0000 && Half(8.940697e-08F).bits() == 0x0002);
+  EXPECT_TRUE(Half(6.1035156e-05F - 2.9802322e-08F).bits() == 0x0400);
+  EXPECT_TRUE(Half(65519.0F).bits() == 0x7bff && Half(65520.0F).bits() == 0x7c00);
+
+  // every half survives a round trip through float
+  std::vector<std::uint16_t> halves(65536);
+  std::vector<float> floats(halves.size());
+  for (std::size_t i = 0; i < halves.size(); ++i) {
+    halves[i] = static_cast<std::uint16_t>(i);
+    floats[i] = static_cast<float>(Half::from_bits(halves[i]));
+    if (floats[i] == floats[i]) {
+      EXPECT_TRUE(Half(floats[i]).bits() == halves[i]);
+    }
+  }
+
+  // float bit patterns across all exponents, including nans and infinities
+  std::vector<float> sweep(100003);
+  for (std::size_t i = 0; i < sweep.size(); ++i) {
+    std::uint32_t u = static_cast<std::uint32_t>(i) * 42949u;
+    std::memcpy(&sweep[i], &u, sizeof(u));
+  }
+
+  auto bits = [](float f) {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+  };
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    std::vector<float> converted(halves.size());
+    morpheus::to_float(morpheus::span<const Half>(reinterpret_cast<const Half*>(halves.data()), halves.size()),
+                       converted);
+    for (std::size_t i = 0; i < halves.size(); ++i) EXPECT_TRUE(bits(converted[i]) == bits(floats[i]));
+
+    std::vector<Half> rounded(sweep.size());
+    morpheus::to_half(sweep, rounded);
+    for (std::size_t i = 0; i < sweep.size(); ++i) EXPECT_TRUE(rounded[i] == Half(sweep[i]));
+
+    // vertex attribute streams
+    std::vector<morpheus::Vector3> normals;
+    for (int i = 0; i < 37; ++i) normals.push_back(normalize(morpheus::Vector3(1.0F, 0.1F * i, -0.5F)));
+    std::vector<morpheus::Vector3h> packed(normals.size());
+    std::vector<morpheus::Vector3> unpacked(normals.size());
+    morpheus::to_half(normals, packed);
+    morpheus::to_float(packed, unpacked);
+    for (std::size_t i = 0; i < normals.size(); ++i) {
+      EXPECT_TRUE(packed[i][0] == to_half(normals[i])[0] && packed[i][2] == to_half(normals[i])[2]);
+      EXPECT_TRUE(   abs(unpacked[i].x() - normals[i].x()) < 0.001F
+                  && abs(unpacked[i].y() - normals[i].y()) < 0.001F
+                  && abs(unpacked[i].z() - normals[i].z()) < 0.001F);
+    }
+  }
+  morpheus::set_simd_level(supported);
+
+  static_assert(sizeof(morpheus::Vector3h) == 6 && sizeof(morpheus::Vector4h) == 8, "halves are packed");
+  morpheus::Vector4h color(1.0F, 0.5F, 0.25F, 1.0F);
+  morpheus::Vector4 c = to_float(color);
+  EXPECT_TRUE(c.x() == 1.0F && c.y() == 0.5F && c.z() == 0.25F && c.w() == 1.0F);
+}
+
+TEST(MathTest, Subpixel) {
+  morpheus::Vector3fx w;
+
+  // center of a 640x480 viewport, y flipped, snapped to 1/256 pixel
+  EXPECT_TRUE(morpheus::to_window(morpheus::Vector4(0.0F, 0.0F, 1.0F, 2.0F), 640.0F, 480.0F, w));
+  EXPECT_TRUE(w.x() == morpheus::Subpixel(320) && w.y() == morpheus::Subpixel(240) && w.z() == morpheus::Subpixel(32768));
+  EXPECT_TRUE(morpheus::to_window(morpheus::Vector4(0.5F, 0.5F, 0.0F, 1.0F), 640.0F, 480.0F, w));
+  EXPECT_TRUE(w.x() == morpheus::Subpixel(480) && w.y() == morpheus::Subpixel(120));
+  EXPECT_TRUE(morpheus::to_window(morpheus::Vector4(1.001F / 640.0F - 1.0F, 1.0F, 0.0F, 1.0F), 640.0F, 480.0F, w));
+  EXPECT_TRUE(morpheus::to_subpixel(w).x() == 128 && morpheus::to_subpixel(w).y() == 0);
+
+  EXPECT_FALSE(morpheus::to_window(morpheus::Vector4(0.0F, 0.0F, 0.0F, 0.0F), 640.0F, 480.0F, w));
+  EXPECT_FALSE(morpheus::to_window(morpheus::Vector4(1e5F, 0.0F, 0.0F, 1.0F), 640.0F, 480.0F, w));
+
+  // clockwise on screen
+  morpheus::Vector2i v0(0, 0);
+  morpheus::Vector2i v1(256 * 4, 0);
+  morpheus::Vector2i v2(0, 256 * 2);
+  std::int64_t area;
+
+  EXPECT_TRUE(morpheus::checked_area(v0, v1, v2, area) && area == 256 * 256 * 8);
+  EXPECT_TRUE(morpheus::checked_area(v0, v2, v1, area) && area == -256 * 256 * 8);
+
+  morpheus::EdgeFunction e;
+  std::int64_t inside, on, outside;
+
+  EXPECT_TRUE(morpheus::make_edge_function(v1, v2, e));
+  EXPECT_TRUE(e.evaluate(morpheus::Vector2i(256, 256), inside) && inside > 0);
+  EXPECT_TRUE(e.evaluate(morpheus::Vector2i(512, 256), on) && on == 0);
+  EXPECT_TRUE(e.evaluate(morpheus::Vector2i(1024, 1024), outside) && outside < 0);
+
+  // setup overflows instead of wrapping around
+  const std::int32_t max = 0x7fffffff;
+  const std::int32_t min = -max - 1;
+
+  EXPECT_FALSE(morpheus::make_edge_function(morpheus::Vector2i(min, min), morpheus::Vector2i(max, max), e));
+  EXPECT_FALSE(morpheus::checked_area(morpheus::Vector2i(max, 0), morpheus::Vector2i(min, 0), v2, area));
+  EXPECT_TRUE(morpheus::make_edge_function(morpheus::Vector2i(0, min), morpheus::Vector2i(max, 0), e));
+  EXPECT_FALSE(e.evaluate(morpheus::Vector2i(min, max), on));
+}
+
+TEST(MathTest, Projection) {
+  const float eps = 1e-5F;
+
+  morpheus::PerspectiveProjection perspective = morpheus::make_perspective(1.2F, 1.5F, 0.5F, 100.0F);
+  morpheus::PerspectiveProjection reverse_z = morpheus::make_reverse_z_infinite_perspective(1.2F, 1.5F, 0.5F);
+  constexpr morpheus::OrthographicProjection orthographic = morpheus::make_orthographic(-2.0F, 6.0F, -1.0F, 3.0F, 1.0F, 11.0F);
+
+  morpheus::Vector4 v(0.3F, -0.7F, -4.0F, 1.0F);
+  morpheus::Point3 p(0.3F, -0.7F, -4.0F);
+
+  // sparse multiply matches the full matrix
+  EXPECT_TRUE(near(perspective * v, perspective.get_matrix() * v, eps) &&
+              near(perspective * p, perspective * v, eps));
+  EXPECT_TRUE(near(reverse_z * v, reverse_z.get_matrix() * v, eps) && near(reverse_z * p, reverse_z * v, eps));
+  EXPECT_TRUE(near(orthographic * v, orthographic.get_matrix() * v, eps) &&
+              near(orthographic * p, orthographic * v, eps));
+
+  // depth at the near and far planes
+  morpheus::Vector4 n = perspective * morpheus::Point3(0.0F, 0.0F, -0.5F);
+  morpheus::Vector4 f = perspective * morpheus::Point3(0.0F, 0.0F, -100.0F);
+
+  EXPECT_TRUE(abs(n.z() / n.w()) < eps && abs(f.z() / f.w() - 1.0F) < eps);
+
+  n = reverse_z * morpheus::Point3(0.0F, 0.0F, -0.5F);
+  f = reverse_z * morpheus::Point3(0.0F, 0.0F, -1e6F);
+
+  EXPECT_TRUE(abs(n.z() / n.w() - 1.0F) < eps && f.z() / f.w() > 0.0F && f.z() / f.w() < eps);
+
+  // the corners of the box go to the corners of clip space
+  EXPECT_TRUE(
+      near(orthographic * morpheus::Point3(-2.0F, -1.0F, -1.0F), morpheus::Vector4(-1.0F, -1.0F, 0.0F, 1.0F), eps));
+  EXPECT_TRUE(
+      near(orthographic * morpheus::Point3(6.0F, 3.0F, -11.0F), morpheus::Vector4(1.0F, 1.0F, 1.0F, 1.0F), eps));
+
+  // the edge of the field of view goes to the edge of clip space
+  morpheus::Vector4 top = perspective * morpheus::Point3(0.0F, 4.0F * std::tan(0.6F), -4.0F);
+
+  EXPECT_TRUE(abs(top.y() / top.w() - 1.0F) < eps);
+}
+
+namespace {
+
+// built at compile time, lives in read-only data
+constexpr morpheus::Matrix3 basis_changes[] = {
+  morpheus::make_scale_matrix(2.0F, 4.0F, 8.0F),
+  morpheus::make_reflection_matrix(morpheus::Vector3(0.0F, 0.0F, 1.0F)),
+  morpheus::Matrix3{{ 0.0F, 1.0F, 0.0F }, { 0.0F, 0.0F, 1.0F }, { 1.0F, 0.0F, 0.0F }}
+};
+
+constexpr morpheus::Transform4 view = {
+  { 1.0F, 0.0F, 0.0F, -1.0F },
+  { 0.0F, 1.0F, 0.0F, -2.0F },
+  { 0.0F, 0.0F, 1.0F, -3.0F }
+};
+
+}  // namespace
+
+TEST(MathTest, ConstexprMath) {
+  constexpr morpheus::Matrix3 scale_inverse = inverse(basis_changes[0]);
+  constexpr morpheus::Vector3 u = morpheus::Vector3(1.0F, 2.0F, 3.0F) * 2.0F;
+  constexpr morpheus::Vector3 v = basis_changes[2] * u;
+  constexpr morpheus::Matrix3 m = basis_changes[1] * basis_changes[0];
+
+  static_assert(basis_changes[0].determinant() == 64.0F, "");
+  static_assert(scale_inverse(0, 0) == 0.5F && scale_inverse(2, 2) == 0.125F, "");
+  static_assert(v.x() == 4.0F && v.y() == 6.0F && v.z() == 2.0F, "");
+  static_assert(m(2, 2) == -8.0F && m(0, 0) == 2.0F, "");
+  static_assert(view(2, 3) == -3.0F && view(3, 3) == 1.0F, "");
+  static_assert(morpheus::Fixed<8>(1.5F) * morpheus::Fixed<8>(2) == morpheus::Fixed<8>(3), "");
+
+  morpheus::Point3 p = view * morpheus::Point3(1.0F, 2.0F, 3.0F);
+
+  EXPECT_TRUE(p.x() == 0.0F && p.y() == 0.0F && p.z() == 0.0F);
+}
+
+TEST(MathTest, Quaternion) {
+  const float eps = 1e-5F;
+  const float pi = 3.14159265F;
+
+  morpheus::Vector3 axis = normalize(morpheus::Vector3(1.0F, 2.0F, 3.0F));
+  morpheus::Quaternion q = morpheus::make_rotation_quaternion(0.7F, axis);
+  morpheus::Quaternion r = morpheus::make_rotation_quaternion(-1.3F, morpheus::Vector3(0.0F, 1.0F, 0.0F));
+
+  EXPECT_TRUE(near(q.get_rotation_matrix(), morpheus::make_rotation_matrix(0.7F, axis), eps));
+
+  // composition matches the matrix product
+  EXPECT_TRUE(near((q * r).get_rotation_matrix(), q.get_rotation_matrix() * r.get_rotation_matrix(), eps));
+
+  morpheus::Vector3 v(0.5F, -1.0F, 2.0F);
+  morpheus::Vector3 qv = rotate(q, v);
+  morpheus::Vector3 mv = morpheus::make_rotation_matrix(0.7F, axis) * v;
+
+  EXPECT_TRUE(abs(qv.x() - mv.x()) < eps && abs(qv.y() - mv.y()) < eps && abs(qv.z() - mv.z()) < eps);
+
+  morpheus::Transform4 h = morpheus::make_transform(q, morpheus::Point3(1.0F, 2.0F, 3.0F));
+  morpheus::Point3 hp = h * morpheus::Point3(v.x(), v.y(), v.z());
+
+  EXPECT_TRUE(abs(hp.x() - mv.x() - 1.0F) < eps && abs(hp.y() - mv.y() - 2.0F) < eps && abs(hp.z() - mv.z() - 3.0F) < eps);
+
+  // halfway between rotations about the same axis, also across the double cover
+  morpheus::Vector3 z(0.0F, 0.0F, 1.0F);
+  morpheus::Quaternion a = morpheus::make_rotation_quaternion(0.2F, z);
+  morpheus::Quaternion b = morpheus::make_rotation_quaternion(1.4F, z);
+  morpheus::Quaternion half = morpheus::make_rotation_quaternion(0.8F, z);
+
+  EXPECT_TRUE(near(slerp(a, b, 0.5F).get_rotation_matrix(), half.get_rotation_matrix(), eps));
+  EXPECT_TRUE(near(slerp(a, b * -1.0F, 0.5F).get_rotation_matrix(), half.get_rotation_matrix(), eps));
+  EXPECT_TRUE(near(nlerp(a, b, 0.5F).get_rotation_matrix(), half.get_rotation_matrix(), eps));
+  EXPECT_TRUE(near(slerp(a, b, 0.25F).get_rotation_matrix(),
+                   morpheus::make_rotation_quaternion(0.5F, z).get_rotation_matrix(), eps));
+  EXPECT_TRUE(abs(slerp(a, a, 0.3F).dot(a) - 1.0F) < eps);
+
+  std::vector<morpheus::Quaternion> qs;
+  for (int i = 0; i < 19; ++i) qs.push_back(morpheus::make_rotation_quaternion(0.1F * i * pi, axis) * r);
+  std::vector<morpheus::Matrix3> ms(qs.size());
+  morpheus::get_rotation_matrices(qs, ms);
+
+  for (std::size_t i = 0; i < qs.size(); ++i) EXPECT_TRUE(near(ms[i], qs[i].get_rotation_matrix(), eps));
+}
+
+TEST(MathTest, SimdDispatch) {
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  EXPECT_TRUE(morpheus::set_simd_level(morpheus::SimdLevel::avx512) == supported);
+
+  morpheus::Transform4 h = {
+    { 0.0F, -1.0F, 0.0F, 1.0F },
+    { 1.0F,  0.0F, 0.0F, 2.0F },
+    { 0.0F,  0.0F, 2.0F, 3.0F }
+  };
+
+  // more than the widest simd width, and not a multiple of it
+  const int count = 37;
+
+  std::vector<morpheus::Point3> points;
+  std::vector<morpheus::Vector3> vectors;
+  std::vector<morpheus::Matrix4> matrices;
+  std::vector<morpheus::Quaternion> quaternions;
+  std::vector<morpheus::Transform4> transforms;
+  for (int i = 0; i < count; ++i) {
+    transforms.emplace_back(morpheus::Vector3(1.0F, 0.1F * i, 0.0F), morpheus::Vector3(0.0F, 2.0F, -0.5F),
+                            morpheus::Vector3(0.2F, 0.0F, 1.0F + i), morpheus::Point3(1.0F * i, -2.0F, 0.5F));
+    points.emplace_back(1.0F * i, 2.0F * i, -1.0F * i);
+    vectors.emplace_back(-1.0F * i, 0.5F * i, 3.0F);
+    // every fifth matrix is singular (its last two columns are equal)
+    float d = i % 5 == 0 ? 1.0F : 4.0F + i;
+    matrices.push_back({{ 2.0F, 0.0F, 1.0F, 1.0F },
+                        { 1.0F, 3.0F, 0.0F, 0.0F },
+                        { 0.0F, 1.0F, 4.0F, 4.0F },
+                        { 1.0F, 0.0F, 1.0F, d    }});
+    quaternions.push_back(morpheus::make_rotation_quaternion(0.1F * i, morpheus::normalize(vectors.back())));
+  }
+
+  float eps = 0.001F;
+
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    auto level = static_cast<morpheus::SimdLevel>(l);
+    EXPECT_TRUE(morpheus::set_simd_level(level) == level);
+    EXPECT_TRUE(morpheus::get_simd_level() == level);
+
+    std::vector<morpheus::Point3> transformed_points(count);
+    morpheus::transform_points(h, points, transformed_points);
+
+    std::vector<float> x(count), y(count), z(count);
+    for (int i = 0; i < count; ++i) {
+      x[i] = vectors[i].x();
+      y[i] = vectors[i].y();
+      z[i] = vectors[i].z();
+    }
+    morpheus::Stream3<float> stream = { x, y, z };
+    morpheus::transform_vectors(h, morpheus::Stream3<const float>{ x, y, z }, stream);
+
+    std::vector<morpheus::Vector3> normalized(count);
+    morpheus::normalize_batch(vectors, normalized);
+
+    std::vector<morpheus::Matrix4> inverses(count);
+    bool flags[count];
+    EXPECT_TRUE(morpheus::inverse_batch(matrices, inverses, flags) == (count + 4) / 5);
+
+    std::vector<morpheus::Matrix3> rotations(count);
+    morpheus::get_rotation_matrices(quaternions, rotations);
+
+    std::vector<morpheus::Transform4> composed(count);
+    std::vector<morpheus::Transform4> reversed(transforms.rbegin(), transforms.rend());
+    morpheus::compose_batch(transforms, reversed, composed);
+
+    std::vector<morpheus::Matrix3> normals(count);
+    morpheus::get_normal_matrices(transforms, normals);
+
+    std::vector<morpheus::Vector3A> padded(vectors.begin(), vectors.end());
+    std::vector<morpheus::Vector3A> padded_points(points.begin(), points.end());
+    morpheus::transform_vectors(h, padded, padded);
+    morpheus::transform_points(h, padded_points, padded_points);
+
+    for (int i = 0; i < count; ++i) {
+      morpheus::Point3 p = h * points[i];
+      EXPECT_TRUE(   abs(transformed_points[i].x() - p.x()) < eps
+                  && abs(transformed_points[i].y() - p.y()) < eps
+                  && abs(transformed_points[i].z() - p.z()) < eps);
+
+      morpheus::Vector3 v = h * vectors[i];
+      EXPECT_TRUE(abs(x[i] - v.x()) < eps && abs(y[i] - v.y()) < eps && abs(z[i] - v.z()) < eps);
+
+      EXPECT_TRUE(   abs(padded[i].x() - v.x()) < eps && abs(padded[i].y() - v.y()) < eps
+                  && abs(padded[i].z() - v.z()) < eps && padded[i].data()[3] == 0.0F);
+      EXPECT_TRUE(   abs(padded_points[i].x() - p.x()) < eps && abs(padded_points[i].y() - p.y()) < eps
+                  && abs(padded_points[i].z() - p.z()) < eps && padded_points[i].data()[3] == 0.0F);
+
+      morpheus::Vector3 n = morpheus::normalize(vectors[i]);
+      EXPECT_TRUE(   abs(normalized[i].x() - n.x()) < eps
+                  && abs(normalized[i].y() - n.y()) < eps
+                  && abs(normalized[i].z() - n.z()) < eps);
+
+      EXPECT_TRUE(flags[i] == (i % 5 == 0));
+      morpheus::Matrix4 identity = flags[i] ? morpheus::Matrix4() : matrices[i] * inverses[i];
+      for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+          float expected = !flags[i] && row == col ? 1.0F : 0.0F;
+          EXPECT_TRUE(abs(identity(row, col) - expected) < eps);
+          if (flags[i]) {
+            EXPECT_TRUE(inverses[i](row, col) == 0.0F);
+          }
+        }
+      }
+
+      morpheus::Matrix3 r = quaternions[i].get_rotation_matrix();
+      for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) EXPECT_TRUE(abs(rotations[i](row, col) - r(row, col)) < eps);
+      }
+
+      morpheus::Transform4 t = transforms[i] * reversed[i];
+      for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) EXPECT_TRUE(abs(composed[i](row, col) - t(row, col)) < eps);
+      }
+
+      morpheus::Matrix3 nm = get_normal_matrix(transforms[i]);
+      for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) EXPECT_TRUE(abs(normals[i](row, col) - nm(row, col)) < eps);
+      }
+    }
+  }
+
+  morpheus::set_simd_level(supported);
+}
+
+TEST(MathTest, Precision) {
+  using fast = morpheus::precision::fast;
+  using precise = morpheus::precision::precise;
+
+  // bounds documented in Precision.hpp, with some slack for the float reference
+  for (int i = -4000; i <= 4000; ++i) {
+    float t = 0.0137F * i;
+    float s, c, fs, fc;
+    morpheus::sincos<precise>(t, s, c);
+    morpheus::sincos<fast>(t, fs, fc);
+
+    EXPECT_TRUE(abs(fs - s) < 2e-7F && abs(fc - c) < 2e-7F);
+    EXPECT_TRUE(morpheus::sin<fast>(t) == fs && morpheus::cos<fast>(t) == fc);
+    if (abs(c) > 0.01F) {
+      float tan = morpheus::tan<precise>(t);
+      EXPECT_TRUE(abs(morpheus::tan<fast>(t) - tan) <= 1e-6F * abs(tan));
+    }
+
+    float x = 1.0F + 0.25F * (i + 4000);
+    EXPECT_TRUE(abs(morpheus::rsqrt<fast>(x) * sqrt(x) - 1.0F) < 5e-7F);
+  }
+
+  morpheus::Vector3 a(3.0F, -4.0F, 12.0F);
+  morpheus::Vector3 n = morpheus::normalize<fast>(a);
+
+  EXPECT_TRUE(abs(n.magnitude() - 1.0F) < 1e-6F && abs(n.z() - 12.0F / 13.0F) < 1e-6F);
+  EXPECT_TRUE(abs(morpheus::normalize<fast>(morpheus::Quaternion(a, 1.0F)).magnitude() - 1.0F) < 1e-6F);
+
+  morpheus::Matrix3 m = morpheus::make_rotation_matrix<precise>(1.1F, n);
+  morpheus::Matrix3 fm = morpheus::make_rotation_matrix<fast>(1.1F, n);
+  morpheus::Matrix3 fx = morpheus::make_rotation_matrix_x<fast>(-2.3F);
+  morpheus::Matrix3 px = morpheus::make_rotation_matrix_x<precise>(-2.3F);
+  morpheus::Matrix3 fk = morpheus::make_skew_matrix<fast>(0.4F, a, n);
+  morpheus::Matrix3 pk = morpheus::make_skew_matrix<precise>(0.4F, a, n);
+
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 3; ++col) {
+      EXPECT_TRUE(   abs(fm(row, col) - m(row, col)) < 1e-6F
+                  && abs(fx(row, col) - px(row, col)) < 1e-6F
+                  && abs(fk(row, col) - pk(row, col)) < 1e-5F);
+    }
+  }
+}
+
+TEST(MathTest, PrecisionBatch) {
+  // a count no multiple of the widest simd width
+  const int count = 8001;
+  std::vector<float> angles(count), sines(count), cosines(count);
+  std::vector<morpheus::Vector3> axes;
+  for (int i = 0; i < count; ++i) {
+    angles[i] = 0.0137F * (i - 4000);
+    axes.push_back(morpheus::normalize(morpheus::Vector3(1.0F, 0.01F * i, -0.5F)));
+  }
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    morpheus::sincos_batch(angles, sines, cosines);
+    std::vector<morpheus::Matrix3> rotations(count);
+    morpheus::make_rotation_matrices(angles, axes, rotations);
+
+    for (int i = 0; i < count; ++i) {
+      float s, c;
+      morpheus::sincos<morpheus::precision::precise>(angles[i], s, c);
+      EXPECT_TRUE(abs(sines[i] - s) < 2e-7F && abs(cosines[i] - c) < 2e-7F);
+
+      morpheus::Matrix3 r = morpheus::make_rotation_matrix<morpheus::precision::fast>(angles[i], axes[i]);
+      for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) EXPECT_TRUE(abs(rotations[i](row, col) - r(row, col)) < 1e-6F);
+      }
+    }
+  }
+  morpheus::set_simd_level(supported);
+}
@@ -0,0 +1,396 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <math/Dispatch.hpp>
+#include <math/Projection.hpp>
+#include <math/Vector4.hpp>
+#include <math/VectorFixed.hpp>
+#include <raster/Framebuffer.hpp>
+#include <raster/Rasterizer.hpp>
+#include <raster/TiledRasterizer.hpp>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+auto to_window(float x, float y, float z) -> morpheus::Vector3fx {
+  return {morpheus::Subpixel(x), morpheus::Subpixel(y), morpheus::Subpixel(z * 65536.0F)};
+}
+
+auto draw(const morpheus::Vector3fx& v0, const morpheus::Vector3fx& v1, const morpheus::Vector3fx& v2,
+          std::uint32_t color, morpheus::Framebuffer& target) -> bool {
+  morpheus::TriangleSetup t;
+  if (!setup_triangle(v0, v1, v2, color, target.get_width(), target.get_height(), t)) return false;
+  rasterize(morpheus::span<const morpheus::TriangleSetup>(&t, 1), target);
+  return true;
+}
+
+// coverage of the center of pixel x, y by the clockwise triangle v, straight from
+// the edge functions
+auto covers(const morpheus::Vector2i v[3], int x, int y) -> bool {
+  morpheus::Vector2i p(x * 256 + 128, y * 256 + 128);
+  for (int k = 0; k < 3; ++k) {
+    morpheus::EdgeFunction f;
+    std::int64_t e;
+    make_edge_function(v[k], v[(k + 1) % 3], f);
+    f.evaluate(p, e);
+    bool top_left = f.a > 0 || (f.a == 0 && f.b > 0);
+    if (e < 0 || (e == 0 && !top_left)) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(RasterTest, FillRule) {
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    // a square with its corners on the centers of pixels 2 and 6: pixels on the top
+    // and left edges are covered, the ones on the bottom and right edges and on the
+    // shared diagonal belong to one triangle only
+    morpheus::Framebuffer target(13, 9);
+    target.clear(0);
+    EXPECT_TRUE(draw(to_window(2.5F, 2.5F, 0.5F), to_window(6.5F, 2.5F, 0.5F), to_window(6.5F, 6.5F, 0.5F), 1, target));
+    EXPECT_TRUE(draw(to_window(2.5F, 2.5F, 0.5F), to_window(2.5F, 6.5F, 0.5F), to_window(6.5F, 6.5F, 0.5F), 2, target));
+    for (int y = 0; y < target.get_height(); ++y) {
+      for (int x = 0; x < target.get_width(); ++x) {
+        bool inside = x >= 2 && x < 6 && y >= 2 && y < 6;
+        std::uint32_t expected = !inside ? 0 : x > y ? 1 : x < y ? 2 : 1;
+        EXPECT_EQ(target.get_color(x, y), expected);
+      }
+    }
+
+    // nearer pixels win regardless of the order, with the depth plane interpolated
+    target.clear(0);
+    EXPECT_TRUE(draw(to_window(0.0F, 0.0F, 0.25F), to_window(13.0F, 0.0F, 0.25F), to_window(0.0F, 9.0F, 0.25F), 3,
+                     target));
+    EXPECT_TRUE(draw(to_window(0.0F, 0.0F, 0.0F), to_window(13.0F, 0.0F, 1.0F), to_window(0.0F, 9.0F, 0.0F), 4,
+                     target));
+    EXPECT_EQ(target.get_color(0, 0), 4U);
+    EXPECT_EQ(target.get_color(6, 0), 3U);
+    EXPECT_TRUE(std::abs(target.get_depth(0, 4) - 0.5F / 13.0F) < 1e-5F);
+
+    // zero area and off target
+    EXPECT_FALSE(draw(to_window(1.0F, 1.0F, 0.0F), to_window(5.0F, 5.0F, 0.0F), to_window(3.0F, 3.0F, 0.0F), 5,
+                      target));
+    EXPECT_FALSE(draw(to_window(-9.0F, 1.0F, 0.0F), to_window(-1.0F, 1.0F, 0.0F), to_window(-5.0F, 8.0F, 0.0F), 5,
+                      target));
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, Watertight) {
+  // a fan of thin triangles around an off-grid center: every pixel inside the fan is
+  // covered exactly once
+  const int n = 23;
+  const float pi = 3.14159265F;
+  std::vector<morpheus::Vector3fx> rim;
+  for (int i = 0; i < n; ++i) {
+    float t = 2.0F * pi * i / n;
+    rim.push_back(to_window(20.3F + 17.7F * std::cos(t), 19.6F + 16.9F * std::sin(t), 0.0F));
+  }
+  morpheus::Vector3fx center = to_window(21.1F, 18.37F, 0.0F);
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+
+    std::vector<int> count(41 * 40, 0);
+    morpheus::Framebuffer target(41, 40);
+    for (int i = 0; i < n; ++i) {
+      target.clear(0);
+      draw(center, rim[i], rim[(i + 1) % n], 1, target);
+      for (int y = 0; y < target.get_height(); ++y) {
+        for (int x = 0; x < target.get_width(); ++x) count[y * 41 + x] += target.get_color(x, y);
+      }
+    }
+
+    int covered = 0;
+    for (int y = 0; y < 40; ++y) {
+      for (int x = 0; x < 41; ++x) {
+        EXPECT_TRUE(count[y * 41 + x] <= 1);
+        // well inside the rim, which is at least 15 pixels from the center
+        float dx = x + 0.5F - 21.1F;
+        float dy = y + 0.5F - 18.37F;
+        if (dx * dx + dy * dy < 12.0F * 12.0F) {
+          EXPECT_EQ(count[y * 41 + x], 1);
+        }
+        covered += count[y * 41 + x];
+      }
+    }
+    EXPECT_TRUE(covered > 700);
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, LargeTriangles) {
+  // large enough for the coarse pass to skip, fill and split blocks
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> x(-20.0F, 120.0F);
+  std::uniform_real_distribution<float> y(-20.0F, 100.0F);
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int i = 0; i < 40; ++i) {
+    morpheus::Vector3fx w[3];
+    morpheus::Vector2i v[3];
+    for (int k = 0; k < 3; ++k) {
+      w[k] = to_window(x(rng), y(rng), 0.5F);
+      v[k] = morpheus::to_subpixel(w[k]);
+    }
+    std::int64_t area = 0;
+    EXPECT_TRUE(morpheus::checked_area(v[0], v[1], v[2], area));
+    if (area < 0) std::swap(v[1], v[2]);
+
+    for (int l = 0; l <= static_cast<int>(supported); ++l) {
+      morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+      morpheus::Framebuffer target(100, 80);
+      target.clear(0);
+      draw(w[0], w[1], w[2], 1, target);
+      for (int py = 0; py < target.get_height(); ++py) {
+        for (int px = 0; px < target.get_width(); ++px) {
+          EXPECT_EQ(target.get_color(px, py), area != 0 && covers(v, px, py) ? 1U : 0U);
+        }
+      }
+    }
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, Levels) {
+  // random triangles at distinct constant depths, some much larger than the target so
+  // that their edge values need 64 bits: every level draws the same pixels
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> small(-1.2F, 1.2F);
+  std::uniform_real_distribution<float> large(-3000.0F, 3000.0F);
+
+  std::vector<morpheus::Vector4> clip;
+  std::vector<std::uint32_t> colors;
+  for (int i = 0; i < 300; ++i) {
+    float z = static_cast<float>((i * 37) % 300) / 300.0F;
+    for (int k = 0; k < 3; ++k) {
+      float x = i % 10 == 0 ? large(rng) : small(rng);
+      float y = i % 10 == 0 ? large(rng) : small(rng);
+      clip.emplace_back(x, y, z, 1.0F);
+    }
+    colors.push_back(static_cast<std::uint32_t>(i + 1));
+  }
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  morpheus::set_simd_level(morpheus::SimdLevel::scalar);
+  morpheus::Framebuffer reference(77, 51);
+  reference.clear(0);
+  std::size_t drawn = draw_triangles(clip, colors, reference);
+  EXPECT_TRUE(drawn > 250);
+
+  for (int l = 1; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+    morpheus::Framebuffer target(77, 51);
+    target.clear(0);
+    EXPECT_EQ(draw_triangles(clip, colors, target), drawn);
+    for (int y = 0; y < target.get_height(); ++y) {
+      for (int x = 0; x < target.get_width(); ++x) EXPECT_EQ(target.get_color(x, y), reference.get_color(x, y));
+    }
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, Tiled) {
+  // overlapping random triangles at a few constant depths: with ties the first
+  // triangle drawn wins, so the result depends on the order within each tile
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> unit(-1.2F, 1.2F);
+  std::vector<morpheus::Vector4> clip;
+  std::vector<std::uint32_t> colors;
+  for (int i = 0; i < 500; ++i) {
+    float z = static_cast<float>(i % 5) / 5.0F;
+    float x = unit(rng);
+    float y = unit(rng);
+    float s = i % 50 == 0 ? 2.0F : 0.3F;
+    // some cross the near plane and get clipped
+    float dz = i % 25 == 0 ? -1.0F : 0.0F;
+    clip.emplace_back(x, y, z, 1.0F);
+    clip.emplace_back(x + s * unit(rng), y + s * unit(rng), z + dz, 1.0F);
+    clip.emplace_back(x + s * unit(rng), y + s * unit(rng), z, 1.0F);
+    colors.push_back(static_cast<std::uint32_t>(i + 1));
+  }
+
+  morpheus::Framebuffer reference(203, 150);
+  reference.clear(0);
+  morpheus::ClipStats stats;
+  std::size_t drawn = draw_triangles(clip, colors, reference, &stats);
+  EXPECT_TRUE(stats.clipped > 0);
+
+  const int tile_sizes[] = {4, 32, 64, 256};
+  for (int tile_size : tile_sizes) {
+    for (int threads = 1; threads <= 3; ++threads) {
+      morpheus::TiledRasterizer tiled(tile_size, threads);
+      EXPECT_EQ(tiled.get_thread_count(), threads);
+      morpheus::Framebuffer target(203, 150);
+      for (int frame = 0; frame < 2; ++frame) {
+        target.clear(0);
+        morpheus::ClipStats tiled_stats;
+        EXPECT_EQ(tiled.draw_triangles(clip, colors, target, &tiled_stats), drawn);
+        EXPECT_EQ(tiled_stats.triangles, stats.triangles);
+        EXPECT_EQ(tiled_stats.culled, stats.culled);
+        EXPECT_EQ(tiled_stats.clipped, stats.clipped);
+      }
+      for (int y = 0; y < target.get_height(); ++y) {
+        for (int x = 0; x < target.get_width(); ++x) EXPECT_EQ(target.get_color(x, y), reference.get_color(x, y));
+      }
+    }
+  }
+}
+
+TEST(RasterTest, TiledSlopedDepth) {
+  // overlapping random triangles on a few sloped planes, so that their depths tie or
+  // nearly tie along most of their overlap: every tile and every way of walking a
+  // triangle must compute the same depth at a pixel as draw_triangles does
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<float> unit(-1.2F, 1.2F);
+  const float slopes[3][2] = {{0.25F, 0.125F}, {-0.1875F, 0.3125F}, {0.0625F, -0.25F}};
+  std::vector<morpheus::Vector4> clip;
+  std::vector<std::uint32_t> colors;
+  for (int i = 0; i < 400; ++i) {
+    const float* slope = slopes[i % 3];
+    float x = unit(rng);
+    float y = unit(rng);
+    float s = i % 20 == 0 ? 2.0F : 0.6F;
+    for (int k = 0; k < 3; ++k) {
+      float vx = k == 0 ? x : x + s * unit(rng);
+      float vy = k == 0 ? y : y + s * unit(rng);
+      clip.emplace_back(vx, vy, 0.5F + slope[0] * vx + slope[1] * vy, 1.0F);
+    }
+    colors.push_back(static_cast<std::uint32_t>(i + 1));
+  }
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+    morpheus::Framebuffer reference(203, 150);
+    reference.clear(0);
+    std::size_t drawn = draw_triangles(clip, colors, reference);
+
+    const int tile_sizes[] = {4, 12, 64};
+    for (int tile_size : tile_sizes) {
+      morpheus::TiledRasterizer tiled(tile_size, 2);
+      morpheus::Framebuffer target(203, 150);
+      target.clear(0);
+      EXPECT_EQ(tiled.draw_triangles(clip, colors, target), drawn);
+      for (int y = 0; y < target.get_height(); ++y) {
+        for (int x = 0; x < target.get_width(); ++x) EXPECT_EQ(target.get_color(x, y), reference.get_color(x, y));
+      }
+    }
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, ReversedDepth) {
+  // a small triangle in front of a larger one through a reverse-z projection, drawn
+  // in both orders: the near one wins with a greater depth test
+  morpheus::PerspectiveProjection projection = morpheus::make_reverse_z_infinite_perspective(1.2F, 1.0F, 0.5F);
+  const morpheus::Point3 view[] = {{-0.5F, -0.5F, -2.0F}, {0.5F, -0.5F, -2.0F}, {0.0F, 0.5F, -2.0F},
+                                   {-8.0F, -8.0F, -10.0F}, {8.0F, -8.0F, -10.0F}, {0.0F, 8.0F, -10.0F}};
+  std::vector<morpheus::Vector4> clip;
+  for (const morpheus::Point3& p : view) clip.push_back(projection * p);
+  std::vector<morpheus::Vector4> swapped(clip.begin() + 3, clip.end());
+  swapped.insert(swapped.end(), clip.begin(), clip.begin() + 3);
+  const std::uint32_t colors[] = {1, 2};
+  const std::uint32_t swapped_colors[] = {2, 1};
+
+  morpheus::SimdLevel supported = morpheus::get_supported_simd_level();
+  for (int l = 0; l <= static_cast<int>(supported); ++l) {
+    morpheus::set_simd_level(static_cast<morpheus::SimdLevel>(l));
+    morpheus::TiledRasterizer tiled(16, 2);
+    morpheus::Framebuffer target(64, 64, morpheus::DepthRange::reversed);
+    EXPECT_EQ(target.get_depth(0, 0), 0.0F);
+
+    EXPECT_EQ(draw_triangles(clip, colors, target), 2u);
+    EXPECT_EQ(target.get_color(32, 32), 1u);
+    EXPECT_TRUE(std::abs(target.get_depth(32, 32) - 0.25F) < 1e-5F);
+    EXPECT_EQ(target.get_color(2, 60), 2u);
+
+    target.clear(0);
+    EXPECT_EQ(draw_triangles(swapped, swapped_colors, target), 2u);
+    EXPECT_EQ(target.get_color(32, 32), 1u);
+
+    target.clear(0);
+    EXPECT_EQ(tiled.draw_triangles(swapped, swapped_colors, target), 2u);
+    EXPECT_EQ(target.get_color(32, 32), 1u);
+    EXPECT_EQ(target.get_color(2, 60), 2u);
+  }
+  morpheus::set_simd_level(supported);
+}
+
+TEST(RasterTest, Clipping) {
+  morpheus::Framebuffer target(64, 48);
+
+  // a screen quad of two triangles far beyond the guard band: clipped to it, and
+  // the parts still cover every pixel exactly once
+  const morpheus::Vector4 quad[] = {{-1e6F, -1e6F, 0.5F, 1.0F}, {1e6F, -1e6F, 0.5F, 1.0F}, {1e6F, 1e6F, 0.5F, 1.0F},
+                                    {-1e6F, 1e6F, 0.5F, 1.0F}};
+  const morpheus::Vector4 halves[2][3] = {{quad[0], quad[1], quad[2]}, {quad[0], quad[2], quad[3]}};
+  morpheus::Framebuffer second(64, 48);
+  target.clear(0);
+  second.clear(0);
+  morpheus::ClipStats stats;
+  const std::uint32_t colors[] = {1};
+  EXPECT_TRUE(draw_triangles(halves[0], colors, target, &stats) >= 1);
+  EXPECT_TRUE(draw_triangles(halves[1], colors, second, &stats) >= 1);
+  EXPECT_EQ(stats.triangles, 2u);
+  EXPECT_EQ(stats.clipped, 2u);
+  for (int y = 0; y < target.get_height(); ++y) {
+    for (int x = 0; x < target.get_width(); ++x) EXPECT_EQ(target.get_color(x, y) + second.get_color(x, y), 1u);
+  }
+
+  // crossing the near plane at y = 0: only the upper half of the screen is drawn
+  const morpheus::Vector4 near[] = {{0.0F, 0.9F, 0.9F, 1.0F}, {-0.9F, -0.9F, -0.9F, 1.0F}, {0.9F, -0.9F, -0.9F, 1.0F}};
+  target.clear(0);
+  stats = morpheus::ClipStats();
+  EXPECT_EQ(draw_triangles(near, colors, target, &stats), 1u);
+  EXPECT_EQ(stats.clipped, 1u);
+  EXPECT_EQ(target.get_color(32, 20), 1u);
+  EXPECT_EQ(target.get_color(32, 28), 0u);
+
+  // the same with reversed depth, where the near plane is z = w
+  const morpheus::Vector4 reversed_near[] = {{0.0F, 0.9F, 0.1F, 1.0F}, {-0.9F, -0.9F, 1.9F, 1.0F},
+                                             {0.9F, -0.9F, 1.9F, 1.0F}};
+  morpheus::Framebuffer reversed(64, 48, morpheus::DepthRange::reversed);
+  stats = morpheus::ClipStats();
+  EXPECT_EQ(draw_triangles(reversed_near, colors, reversed, &stats), 1u);
+  EXPECT_EQ(stats.clipped, 1u);
+  EXPECT_EQ(reversed.get_color(32, 20), 1u);
+  EXPECT_EQ(reversed.get_color(32, 28), 0u);
+  EXPECT_TRUE(reversed.get_depth(32, 23) <= 1.0F);
+
+  // partly off screen but inside the guard band: straight to setup. entirely
+  // outside the view volume: culled
+  const morpheus::Vector4 others[] = {{0.0F, 0.0F, 0.5F, 1.0F}, {5.0F, 0.0F, 0.5F, 1.0F}, {0.0F, -5.0F, 0.5F, 1.0F},
+                                      {1.5F, 0.0F, 0.5F, 1.0F}, {3.0F, 0.0F, 0.5F, 1.0F}, {1.5F, 1.0F, 0.5F, 1.0F}};
+  const std::uint32_t other_colors[] = {1, 2};
+  target.clear(0);
+  stats = morpheus::ClipStats();
+  EXPECT_EQ(draw_triangles(others, other_colors, target, &stats), 1u);
+  EXPECT_EQ(stats.triangles, 2u);
+  EXPECT_EQ(stats.culled, 1u);
+  EXPECT_EQ(stats.clipped, 0u);
+  EXPECT_EQ(target.get_color(40, 30), 1u);
+
+  // orthographic, with one vertex so far past the far plane that its depth doesn't
+  // fit in to_window: clipped there, the part in front of the far plane is drawn
+  // with its depth unchanged
+  const morpheus::Vector4 far[] = {{-0.9F, 0.9F, 0.0F, 1.0F}, {-0.9F, -0.9F, 0.0F, 1.0F}, {400.0F, 0.0F, 1000.0F, 1.0F}};
+  target.clear(0);
+  stats = morpheus::ClipStats();
+  EXPECT_TRUE(draw_triangles(far, colors, target, &stats) >= 1);
+  EXPECT_EQ(stats.clipped, 1u);
+  EXPECT_EQ(target.get_color(4, 24), 1u);
+  EXPECT_EQ(target.get_color(30, 24), 0u);
+  // window x from 3.2 at depth 0 to 12832 at depth 1000
+  EXPECT_TRUE(std::abs(target.get_depth(4, 24) - (4.5F - 3.2F) * 1000.0F / 12828.8F) < 1e-4F);
+}